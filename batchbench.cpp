@@ -0,0 +1,92 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+// Microbenchmark of the batch trick evaluation: the scalar path against
+// each vector kernel the CPU supports, checking they all agree
+
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include "rng.hpp"
+#include "trickbatch.hpp"
+
+#define N_BATCHES 256  // Per trumph suit
+#define N_PASSES 2000
+
+static const char* kernel_names[] = { "Scalar", "SSE4.1", "AVX2" };
+
+int main()
+{
+  static TrickBatch batches[N_SUITS][N_BATCHES];
+  static unsigned char winners[N_SUITS][N_BATCHES * TRICK_BATCH];
+  static unsigned char points[N_SUITS][N_BATCHES * TRICK_BATCH];
+  static unsigned char ref_winners[N_SUITS][N_BATCHES * TRICK_BATCH];
+  static unsigned char ref_points[N_SUITS][N_BATCHES * TRICK_BATCH];
+  Rng rng( 1 );
+  for( int trumph = 0; trumph < N_SUITS; trumph++ )
+    for( int b = 0; b < N_BATCHES; b++ )
+      for( int w = 0; w < TRICK_BATCH; w++ )
+        for( int i = 0; i < N_TRICK_CARDS; i++ ) {
+          bool repeated;
+          cardid_t card;
+          do {
+            card = (cardid_t)rng.Below( N_CARDS );
+            repeated = false;
+            for( int j = 0; j < i; j++ )
+              repeated |= batches[trumph][b].cards[j][w] == card;
+          } while( repeated );
+          batches[trumph][b].cards[i][w] = card;
+        }
+  for( int trumph = 0; trumph < N_SUITS; trumph++ )
+    EvalTrickBatches( batches[trumph], N_BATCHES, (cardsuit_t)trumph,
+                      ref_winners[trumph], ref_points[trumph], TRICK_KERNEL_SCALAR );
+
+  typedef std::chrono::steady_clock clock_type;
+  trickkernel_t best = BestTrickKernel();
+  double scalar_ns = 0;
+  int status = 0;
+  for( int k = TRICK_KERNEL_SCALAR; k <= best; k++ ) {
+    trickkernel_t kernel = (trickkernel_t)k;
+    for( int trumph = 0; trumph < N_SUITS; trumph++ ) {
+      EvalTrickBatches( batches[trumph], N_BATCHES, (cardsuit_t)trumph,
+                        winners[trumph], points[trumph], kernel );
+      if( memcmp( winners[trumph], ref_winners[trumph], sizeof( winners[trumph] ) ) ||
+          memcmp( points[trumph], ref_points[trumph], sizeof( points[trumph] ) ) ) {
+        fprintf( stderr, "%s kernel differs from the scalar one\n", kernel_names[k] );
+        status = 1;
+      }
+    }
+    unsigned long sum = 0;
+    clock_type::time_point start = clock_type::now();
+    for( int pass = 0; pass < N_PASSES; pass++ )
+      for( int trumph = 0; trumph < N_SUITS; trumph++ ) {
+        EvalTrickBatches( batches[trumph], N_BATCHES, (cardsuit_t)trumph,
+                          winners[trumph], points[trumph], kernel );
+        sum += winners[trumph][pass % N_BATCHES] + points[trumph][pass % N_BATCHES];
+      }
+    clock_type::time_point end = clock_type::now();
+    double n = (double)N_PASSES * N_SUITS * N_BATCHES * TRICK_BATCH;
+    double ns = std::chrono::duration<double, std::nano>( end - start ).count() / n;
+    if( kernel == TRICK_KERNEL_SCALAR )
+      scalar_ns = ns;
+    printf( "%-7s %6.3f ns/trick %6.2fx (checksum %lu)\n",
+            kernel_names[k], ns, scalar_ns / ns, sum );
+  }
+  return status;
+}
@@ -0,0 +1,156 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+// sueca-bookgen: builds the opening lead book, offline. Random hands of
+// the first player of a round get their lead from a pimc bot given many
+// more worlds (and time) than at the table.
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <vector>
+#include "leadbook.hpp"
+#include "pimcbot.hpp"
+#include "workpool.hpp"
+
+#define BOOKGEN_WORLDS ( 4 * PIMC_WORLDS )
+
+class BookJob: public PoolJob
+{
+public:
+  BookJob( int worlds, uint64_t seed, int threads );
+  ~BookJob();
+  void Run( long item, int worker );
+  // All the workers' entries, in one vector
+  void Collect( std::vector<LeadBookEntry>& entries );
+private:
+  uint64_t m_seed;
+  std::vector<PimcBot*> m_bots;  // One per thread, single threaded
+  std::vector< std::vector<LeadBookEntry> > m_entries;
+};
+
+BookJob::BookJob( int worlds, uint64_t seed, int threads ):
+  m_seed( seed ), m_bots( threads ), m_entries( threads )
+{
+  for( int i = 0; i < threads; i++ )
+    m_bots[i] = new PimcBot( 1, 0, worlds );
+}
+
+BookJob::~BookJob()
+{
+  for( size_t i = 0; i < m_bots.size(); i++ )
+    delete m_bots[i];
+}
+
+void BookJob::Run( long item, int worker )
+{
+  Engine engine;
+  uint64_t seed = m_seed ^ ( item * 0x9e3779b97f4a7c15ULL );
+  engine.Seed( seed );
+  engine.NewGame( item % N_SEATS );
+  engine.NewRound();
+  int seat = engine.GetTurn();
+  CardSet hand = engine.GetHand( seat );
+  PimcBot& bot = *m_bots[worker];
+  bot.Seed( seed );
+  bot.NewGame( seat );
+  bot.NewRound( hand, engine.GetTrumph(), engine.GetTrumphOwner() );
+  cardid_t lead = bot.PlayCard( hand, NULL, 0 );
+  cardsuit_t trumph = CardIdSuit( engine.GetTrumph() );
+  LeadBookEntry entry;
+  entry.key = LeadBook::Key( hand, engine.GetTrumph() );
+  entry.lead = LeadBook::ToBook( hand, trumph, lead );
+  m_entries[worker].push_back( entry );
+}
+
+void BookJob::Collect( std::vector<LeadBookEntry>& entries )
+{
+  for( size_t i = 0; i < m_entries.size(); i++ ) {
+    entries.insert( entries.end(), m_entries[i].begin(), m_entries[i].end() );
+    std::vector<LeadBookEntry>().swap( m_entries[i] );
+  }
+}
+
+static void Usage()
+{
+  fprintf( stderr,
+           "Usage: sueca-bookgen [options] [file]\n"
+           "Finds the opening lead of random hands and writes them to file (default " LEADBOOK_FILE ").\n"
+           "Options:\n"
+           "  -n HANDS      number of hands (default 10000)\n"
+           "  -w WORLDS     worlds solved for every hand (default %d)\n"
+           "  -t THREADS    worker threads (default: one per core)\n"
+           "  -s SEED       random seed (default: random)\n", BOOKGEN_WORLDS );
+}
+
+int main( int argc, char** argv )
+{
+  long hands = 10000;
+  int worlds = BOOKGEN_WORLDS;
+  int threads = 0;
+  uint64_t seed = Rng::RandomSeed();
+  const char* path = LEADBOOK_FILE;
+  bool haspath = false;
+  for( int i = 1; i < argc; i++ ) {
+    if( argv[i][0] == '-' && argv[i][1] && !argv[i][2] && i + 1 < argc ) {
+      const char* value = argv[++i];
+      switch( argv[i - 1][1] ) {
+      case 'n':
+        hands = atol( value );
+        continue;
+      case 'w':
+        worlds = atoi( value );
+        continue;
+      case 't':
+        threads = atoi( value );
+        continue;
+      case 's':
+        seed = strtoull( value, NULL, 0 );
+        continue;
+      }
+    }
+    else if( argv[i][0] != '-' && !haspath ) {
+      path = argv[i];
+      haspath = true;
+      continue;
+    }
+    Usage();
+    return 1;
+  }
+  if( hands <= 0 || worlds <= 0 ) {
+    Usage();
+    return 1;
+  }
+
+  WorkPool pool( threads );
+  BookJob job( worlds, seed, pool.GetThreads() );
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  pool.Run( job, hands );
+  std::vector<LeadBookEntry> entries;
+  job.Collect( entries );
+  if( !LeadBook::Write( path, entries ) ) {
+    fprintf( stderr, "Could not write %s\n", path );
+    return 1;
+  }
+  double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+  printf( "%ld hands, %d worlds each, %d threads, seed %llu\n", hands, worlds,
+          pool.GetThreads(), (unsigned long long)seed );
+  printf( "Written to %s in %.2f s\n", path, seconds );
+  return 0;
+}
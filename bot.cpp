@@ -0,0 +1,86 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <cstring>  // For strcmp()
+#include "bot.hpp"
+#include "smartbot.hpp"
+#include "pimcbot.hpp"
+#include "ismctsbot.hpp"
+
+const char* const Bot::names[] = { "dumb", "smart", "pimc", "ismcts", NULL };
+const char* const Bot::level_names[N_BOT_LEVELS] = { "Easy", "Medium", "Hard", "Expert" };
+const int Bot::level_budgets[N_BOT_LEVELS] = { 25, 100, 500, 2000 };
+
+Bot* Bot::Create( const char* name )
+{
+  if( !strcmp( name, "dumb" ) )
+    return new DumbBot();
+  if( !strcmp( name, "smart" ) )
+    return new SmartBot();
+  // Single threaded, with no time limit, so that simulations (already
+  // running on all cores) can replay the same games
+  if( !strcmp( name, "pimc" ) )
+    return new PimcBot();
+  if( !strcmp( name, "ismcts" ) )
+    return new IsmctsBot();
+  return NULL;
+}
+
+// Dumb bot implementation
+cardid_t DumbBot::PlayCard( CardSet hand, const cardid_t* played, int nplayed )
+{
+  return Engine::LegalMoves( hand, nplayed ? played[0] : NO_CARD ).First();
+}
+
+// Bot table implementation
+BotTable::BotTable( Engine& engine, Bot** bots ):
+  m_engine( engine ), m_bots( bots ) {}
+
+void BotTable::NewGame( int dealer )
+{
+  m_engine.NewGame( dealer );
+  for( int seat = 0; seat < N_SEATS; seat++ )
+    m_bots[seat]->NewGame( seat );
+}
+
+unsigned short BotTable::PlayRound( int* winteam )
+{
+  m_engine.NewRound();
+  for( int seat = 0; seat < N_SEATS; seat++ )
+    m_bots[seat]->NewRound( m_engine.GetHand( seat ), m_engine.GetTrumph(),
+                            m_engine.GetTrumphOwner() );
+  while( !m_engine.IsRoundOver() ) {
+    cardid_t trick[N_SEATS];
+    int leader = m_engine.GetLeader();
+    for( int i = 0; i < N_SEATS; i++ ) {
+      int seat = m_engine.GetTurn();
+      cardid_t card = m_bots[seat]->PlayCard( m_engine.GetHand( seat ), trick, i );
+      // A misbehaving bot must not stall the table
+      if( m_engine.PlayMove( seat, card ) != MOVE_OK ) {
+        card = Engine::LegalMoves( m_engine.GetHand( seat ), m_engine.GetLead() ).First();
+        m_engine.ForceMove( seat, card );
+      }
+      trick[i] = card;
+    }
+    m_engine.EndTrick();
+    for( int seat = 0; seat < N_SEATS; seat++ )
+      m_bots[seat]->TrickEnd( leader, trick );
+  }
+  return m_engine.CalcWonGames( winteam );
+}
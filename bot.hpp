@@ -0,0 +1,91 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _BOT_HPP_
+#define _BOT_HPP_ 1
+
+// Forward declarations
+class Bot;
+class DumbBot;
+class BotTable;
+
+#include "engine.hpp"
+
+// Strength levels of the computer players, as the time they get to think
+#define N_BOT_LEVELS 4
+#define BOT_DEFAULT_LEVEL 2
+
+// Headless computer player (abstract class)
+// Seats are the engine ones. Only what a player at the table would see is
+// passed on, so the same bot can play on the GUI or in simulations.
+class Bot
+{
+public:
+  Bot(): m_seat( 0 ) {}
+  virtual ~Bot() {}
+  virtual void NewGame( int seat ) { m_seat = seat; }
+  // For bots making random choices, to replay the same games
+  virtual void Seed( uint64_t seed ) {}
+  // For bots that search: most time (in ms) and nodes for a move, 0 for
+  // no limit. The best move found so far is played when either runs out.
+  virtual void SetBudget( int budget, unsigned long nodes = 0 ) {}
+  virtual void NewRound( CardSet hand, cardid_t trumph, int owner ) {}
+  // Cards of a complete trick, starting with the leader's
+  virtual void TrickEnd( int leader, const cardid_t* played ) {}
+  // Must return a legal card of the hand
+  virtual cardid_t PlayCard( CardSet hand, const cardid_t* played, int nplayed ) = 0;
+  // Thinks ahead while the seat before this one decides (played is the
+  // trick so far), so that PlayCard can answer at once if the card it
+  // plays was foreseen. Never at the same time as PlayCard.
+  virtual void Ponder( CardSet hand, const cardid_t* played, int nplayed ) {}
+  // From any thread, even before Ponder() starts: the seat before played
+  // this card (NO_CARD if none is coming), pondering on others stops
+  virtual void StopPondering( cardid_t card = NO_CARD ) {}
+  int GetSeat() const { return m_seat; }
+  // Bot by name ("dumb", "smart", "pimc", "ismcts"), NULL if there is none
+  static Bot* Create( const char* name );
+  static const char* const names[];
+  // Names and time budgets (in ms) of the strength levels
+  static const char* const level_names[N_BOT_LEVELS];
+  static const int level_budgets[N_BOT_LEVELS];
+protected:
+  int m_seat;
+};
+
+// Dumb bot: plays the first legal card
+class DumbBot: public Bot
+{
+public:
+  cardid_t PlayCard( CardSet hand, const cardid_t* played, int nplayed );
+};
+
+// Plays whole rounds between four bots (one per seat), without any display
+class BotTable
+{
+public:
+  BotTable( Engine& engine, Bot** bots );
+  void NewGame( int dealer );
+  // Deals and plays a round, returns the victories as CalcWonGames
+  unsigned short PlayRound( int* winteam );
+private:
+  Engine& m_engine;
+  Bot** m_bots;
+};
+
+#endif  // _BOT_HPP_
@@ -0,0 +1,109 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include "canonical.hpp"
+
+#define ZERO_RANKS ( QUEEN - TWO )  // Two to Six
+#define ZERO_MASK ( ( 1 << ZERO_RANKS ) - 1 )
+
+// Non trumph suits by decreasing key, the trumph first: suits[i] is the
+// suit becoming suit i
+static void SortSuits( const cardmask_t* keys, cardsuit_t trumph, int* suits )
+{
+  int n = 0;
+  suits[n++] = trumph;
+  for( int suit = 0; suit < N_SUITS; suit++ ) {
+    if( suit == trumph )
+      continue;
+    int i = n++;
+    for( ; i > 1 && keys[suits[i - 1]] < keys[suit]; i-- )
+      suits[i] = suits[i - 1];
+    suits[i] = suit;
+  }
+}
+
+// Canonical position implementation
+void CanonicalPosition::Set( const CardSet* hands, cardsuit_t trumph, int leader )
+{
+  m_leader = leader;
+  m_inplay = hands[0] | hands[1] | hands[2] | hands[3];
+  // Key of a suit: who holds which of its cards, ten bits per seat, so
+  // suits that can be swapped have the same key
+  cardmask_t keys[N_SUITS];
+  for( int suit = 0; suit < N_SUITS; suit++ ) {
+    cardmask_t key = 0;
+    for( int seat = 0; seat < N_SEATS; seat++ )
+      key |= ( ( hands[seat].GetMask() >> ( suit * N_RANKS ) ) & SUIT_MASK ) << ( seat * N_RANKS );
+    // Zero point cards moved down, when not already the lowest ranks
+    unsigned int low = ( m_inplay.GetMask() >> ( suit * N_RANKS ) ) & ZERO_MASK;
+    if( low & ( low + 1 ) ) {
+      cardmask_t moved = 0;
+      for( int rank = 0; low; low &= low - 1, rank++ ) {
+        int from = __builtin_ctz( low );
+        moved |= ( ( key >> from ) & RANK_MASK( 0 ) ) << rank;
+      }
+      key = ( key & ~( RANK_MASK( 0 ) * ZERO_MASK ) ) | moved;
+    }
+    keys[suit] = key;
+  }
+  int suits[N_SUITS];
+  SortSuits( keys, trumph, suits );
+  // Hashed suit by suit, a key per suit position keeps them apart
+  m_hash = zobrist_keys.turn[leader];
+  for( int i = 0; i < N_SUITS; i++ ) {
+    m_suits[suits[i]] = i;
+    m_keys[i] = keys[suits[i]];
+    m_hash ^= MixBits( m_keys[i] ^ zobrist_keys.trumph[i] );
+  }
+}
+
+CardSet CanonicalPosition::GetHand( int seat ) const
+{
+  cardmask_t mask = 0;
+  for( int i = 0; i < N_SUITS; i++ )
+    mask |= ( ( m_keys[i] >> ( seat * N_RANKS ) ) & SUIT_MASK ) << ( i * N_RANKS );
+  return CardSet( mask );
+}
+
+cardid_t CanonicalPosition::GetCard( cardid_t card ) const
+{
+  int suit = CardIdSuit( card );
+  int rank = CardIdRank( card );
+  if( !CardIdValue( card ) ) {
+    unsigned int inplay = ( m_inplay.GetMask() >> ( suit * N_RANKS ) ) & SUIT_MASK;
+    rank = __builtin_popcount( inplay & ( ( 1 << rank ) - 1 ) );
+  }
+  return m_suits[suit] * N_RANKS + rank;
+}
+
+CardSet CanonicalHand( CardSet hand, cardsuit_t trumph, unsigned char* suits )
+{
+  cardmask_t keys[N_SUITS];
+  for( int suit = 0; suit < N_SUITS; suit++ )
+    keys[suit] = ( hand.GetMask() >> ( suit * N_RANKS ) ) & SUIT_MASK;
+  int order[N_SUITS];
+  SortSuits( keys, trumph, order );
+  cardmask_t mask = 0;
+  for( int i = 0; i < N_SUITS; i++ ) {
+    mask |= keys[order[i]] << ( i * N_RANKS );
+    if( suits )
+      suits[order[i]] = i;
+  }
+  return CardSet( mask );
+}
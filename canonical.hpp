@@ -0,0 +1,58 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _CANONICAL_HPP_
+#define _CANONICAL_HPP_ 1
+
+// Forward declarations
+class CanonicalPosition;
+
+#include <stdint.h>
+#include "zobrist.hpp"
+
+// Position relabeled so that positions with the same outcome look the
+// same, for keying tables:
+// - the suits only matter as trumph or not, so the trumph becomes clubs
+//   and the other suits follow, sorted by who holds which cards of them
+// - zero point cards of a suit can only be told apart by their order, so
+//   those in play take the lowest ranks of their suit, in the same order
+// Only for positions between tricks.
+class CanonicalPosition
+{
+public:
+  void Set( const CardSet* hands, cardsuit_t trumph, int leader );
+  CardSet GetHand( int seat ) const;
+  int GetLeader() const { return m_leader; }
+  // Canonical card of a card in play
+  cardid_t GetCard( cardid_t card ) const;
+  uint64_t GetHash() const { return m_hash; }
+private:
+  cardmask_t m_keys[N_SUITS];  // Cards of each canonical suit, by seat
+  uint64_t m_hash;
+  CardSet m_inplay;  // Before relabeling
+  unsigned char m_suits[N_SUITS];  // Canonical suit of each suit
+  int m_leader;
+};
+
+// A single hand with the suits relabeled the same way, e.g. for a whole
+// hand at the start of a round (no card is out yet). Suits, if given,
+// gets the canonical suit of each suit.
+CardSet CanonicalHand( CardSet hand, cardsuit_t trumph, unsigned char* suits = NULL );
+
+#endif  // _CANONICAL_HPP_
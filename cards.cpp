@@ -17,39 +17,27 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 */
 
-#include <cstdlib>  // for rand() and srand()
-#include <ctime>  // time()
 #include "cards.hpp"
 #include <wx/dcmemory.h>
 
 #include <wx/listimpl.cpp>
 WX_DEFINE_LIST( CardList );
 
-// Card type implementation
-CardType::CardType( cardtype_t id, char* name, char *shortname, short value ):
-  m_id( id ), m_name ( name ), m_shortname( shortname ), m_value ( value ) {}
-
-// Card suit implementation
-CardSuit::CardSuit( cardsuit_t id ):
-  m_id( id ), m_name ( "" ), m_bitmap( wxNullBitmap ) {}
-CardSuit::CardSuit( cardsuit_t id, char* name, char* xpmdata[] ):
-  m_id( id ), m_name ( name ), m_bitmap( xpmdata ) {}
-
 // Card implementation
-Card::Card( Deck *deck, CardType& type, CardSuit& suit, char** xpmdata):
-  m_deck( deck ), m_type( type ), m_suit( suit ), m_turned( false ),
-  m_playable( false ), m_bitmap( xpmdata ), blitop( wxCOPY ) {}
+Card::Card( Deck *deck, cardid_t id ):
+  m_deck( deck ), m_id( id ), m_turned( false ),
+  m_playable( false ), m_bitmap( &CardArt::Get().GetBitmap( id ) ), blitop( wxCOPY ) {}
 
 wxString Card::NameStr()
 {
-  return ( wxString( m_type.GetName() ) + wxString( " of " ) +
-           wxString( m_suit.GetName() ) );
+  return ( wxString( CardIdName( m_id ) ) + wxString( " of " ) +
+           wxString( CardIdSuitName( m_id ) ) );
 }
 
 wxString Card::ShortStr()
 {
-  return wxString::Format( "%s%c", m_type.GetShortName(),
-			   m_suit.GetName()[0] );
+  return wxString::Format( "%c%c", CardIdLetter( m_id ),
+			   CardIdSuitLetter( m_id ) );
 }
 
 bool Card::HitTest( const wxPoint& pt ) const
@@ -79,46 +67,13 @@ void Card::ColorInvert( bool inverted )
   blitop = inverted ? wxSRC_INVERT : wxCOPY;
 }
 
-// Permanent card types
-static CardType typeNul( UNKNOWN_CARD_TYPE, "", "", 0 );
-static CardType typeTwo( TWO, "Two", "2", 0 );
-static CardType typeThree( THREE, "Three", "3", 0 );
-static CardType typeFour( FOUR, "Four", "4", 0 );
-static CardType typeFive( FIVE, "Five", "5", 0 );
-static CardType typeSix( SIX, "Six", "6", 0 );
-static CardType typeQueen( QUEEN, "Queen", "Q", 2 );
-static CardType typeJack( JACK, "Jack", "J", 3 );
-static CardType typeKing( KING, "King", "K", 4 );
-static CardType typeSeven( SEVEN, "Seven", "7", 10 );
-static CardType typeAce( ACE, "Ace", "A", 11 );
-
-// Permanent card suits
-class SuitNul: public CardSuit
-{
-public: SuitNul(): CardSuit( UNKNOWN_CARD_SUIT ) {}
-};
+// Suit symbols
 #include "xpm_cards/clubs.xpm"
-class SuitClubs: public CardSuit
-{
-public: SuitClubs(): CardSuit( CLUBS, "Clubs", clubs_xpm ) {}
-};
 #include "xpm_cards/diamonds.xpm"
-class SuitDiamonds: public CardSuit
-{
-public: SuitDiamonds(): CardSuit( DIAMONDS, "Diamonds", diamonds_xpm ) {}
-};
 #include "xpm_cards/hearts.xpm"
-class SuitHearts: public CardSuit
-{
-public: SuitHearts(): CardSuit( HEARTS, "Hearts", hearts_xpm ) {}
-};
 #include "xpm_cards/spades.xpm"
-class SuitSpades: public CardSuit
-{
-public: SuitSpades(): CardSuit ( SPADES, "Spades", spades_xpm ) {}
-};
 
-// Deck implementation
+// Card art implementation
 //#include "xpm_cards/b1fh.xpm"
 // TODO: Add more faces
 #include "xpm_cards/b1fv.xpm"
@@ -190,58 +145,54 @@ public: SuitSpades(): CardSuit ( SPADES, "Spades", spades_xpm ) {}
 #include "xpm_cards/sj.xpm"
 #include "xpm_cards/sk.xpm"
 #include "xpm_cards/sq.xpm"
-Deck::Deck():
+CardArt* CardArt::instance = NULL;
+
+const CardArt& CardArt::Get()
+{
+  if( !instance )
+    instance = new CardArt();
+  return *instance;
+}
+
+void CardArt::Free()
+{
+  delete instance;
+  instance = NULL;
+}
+
+CardArt::CardArt():
   m_face( DECK_FACE )
 {
-  SuitNul nulsuit;
-  nulcard = new Card( this, typeNul, nulsuit, DECK_FACE );
-  CardSuit suits[] = {
-    SuitHearts(),
-    SuitClubs(),
-    SuitDiamonds(),
-    SuitSpades()
-  };
-  CardType types[] = {
-    typeTwo,
-    typeThree,
-    typeFour,
-    typeFive,
-    typeSix,
-    typeQueen,
-    typeJack,
-    typeKing,
-    typeSeven,
-    typeAce
-  };
-  char** xpms[4][10] = {
-    { h2, h3, h4, h5, h6, hq, hj, hk, h7, h1 },
+  // Same order as cardsuit_t
+  char** suitxpms[N_SUITS] = { clubs_xpm, diamonds_xpm, spades_xpm, hearts_xpm };
+  // Same order as card ranks, so that m_cards[] is indexed by card id
+  char** xpms[N_SUITS][N_RANKS] = {
     { c2, c3, c4, c5, c6, cq, cj, ck, c7, c1 },
     { d2, d3, d4, d5, d6, dq, dj, dk, d7, d1 },
-    { s2, s3, s4, s5, s6, sq, sj, sk, s7, s1 }
+    { s2, s3, s4, s5, s6, sq, sj, sk, s7, s1 },
+    { h2, h3, h4, h5, h6, hq, hj, hk, h7, h1 }
   };
-  int n = 0;
-  for( int s = 0; s < 4; s++ )
-    for( int t = 0; t < 10; t++ ) {
-      Card* card = new Card( this, types[t], suits[s], xpms[s][t] );
-      cards[n++] = card;
-      cardmap[card->ShortStr()] = card;
-    }
+  for( int s = 0; s < N_SUITS; s++ ) {
+    m_suits[s] = wxBitmap( suitxpms[s] );
+    for( int t = 0; t < N_RANKS; t++ )
+      m_cards[s * N_RANKS + t] = wxBitmap( xpms[s][t] );
+  }
 }
 
-Deck::~Deck()
+// Deck implementation
+Deck::Deck()
 {
-  delete nulcard;
-  for( int i = 0; i < 40; i++ )
-    delete cards[i];
+  nulcard = new Card( this, NO_CARD );
+  for( int i = 0; i < N_CARDS; i++ ) {
+    Card* card = new Card( this, (cardid_t)i );
+    cards[i] = card;
+    cardmap[card->ShortStr()] = card;
+  }
 }
 
-void Deck::Shuffle()
+Deck::~Deck()
 {
-  for( int i = 0; i < 40; i++ ) {
-    int r1 = (int)( 40.0 * rand() / ( RAND_MAX + 1.0 ) );
-    int r2 = (int)( 40.0 * rand() / ( RAND_MAX + 1.0 ) );
-    Card* t = cards[r1];
-    cards[r1] = cards[r2];
-    cards[r2] = t;
-  }
+  delete nulcard;
+  for( int i = 0; i < N_CARDS; i++ )
+    delete cards[i];
 }
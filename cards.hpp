@@ -21,8 +21,7 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #define _CARDS_HPP_ 1
 
 // Forward declarations
-class CardType;
-class CardSuit;
+class CardArt;
 class Card;
 class CardList;
 class Deck;
@@ -33,77 +32,59 @@ class Deck;
 #include <wx/list.h>
 #include <wx/hashmap.h>
 #include <wx/timer.h>
+#include "corecards.hpp"
 
-// Card types
-enum cardtype_t { TWO=2, THREE, FOUR, FIVE, SIX, QUEEN, JACK, KING, SEVEN, ACE, UNKNOWN_CARD_TYPE };
-class CardType
+// Card images
+// Decoded once, on first use, and shared by every Deck and canvas. Only
+// used from the GUI thread.
+class CardArt
 {
 public:
-  CardType( cardtype_t id, char* name, char* shortname, short value );
-  cardtype_t GetId() const { return m_id; }
-  unsigned short GetValue() const { return m_value; }
-  char* GetName() const { return m_name; }
-  char* GetShortName() const { return m_shortname; }
-  bool operator !=( const CardType& other ) { return m_id != other.GetId(); }
-  bool operator ==( const CardType& other ) { return m_id == other.GetId(); }
-  bool operator <( const CardType& other ) { return m_id < other.GetId(); }
-  bool operator >( const CardType& other ) { return m_id > other.GetId(); }
+  static const CardArt& Get();
+  static void Free();
+  // The card's face, or its back for NO_CARD
+  const wxBitmap& GetBitmap( cardid_t id ) const { return id == NO_CARD ? m_face : m_cards[id]; }
+  const wxBitmap& GetFace() const { return m_face; }
+  const wxBitmap& GetSuitBitmap( cardsuit_t suit ) const { return m_suits[suit]; }
 private:
-  cardtype_t m_id;
-  char* m_name;
-  char* m_shortname;
-  unsigned short m_value;
-};
-
-// Card suits
-enum cardsuit_t { CLUBS=0, DIAMONDS, SPADES, HEARTS, UNKNOWN_CARD_SUIT };
-#define SUITMIN CLUBS
-#define SUITMAX HEARTS
-class CardSuit
-{
-public:
-  CardSuit( cardsuit_t id );  // For nul type
-  CardSuit( cardsuit_t id, char* name, char* xpmdata[] );
-  cardsuit_t GetId() const { return m_id; }
-  char* GetName() const { return m_name; }
-  wxBitmap& GetBitmap() const { return (wxBitmap&)m_bitmap; }
-  bool operator !=( const CardSuit& other ) { return m_id != other.GetId(); }
-  bool operator ==( const CardSuit& other ) { return m_id == other.GetId(); }
-  bool operator <( const CardSuit& other ) { return m_id < other.GetId(); }
-  bool operator >( const CardSuit& other ) { return m_id > other.GetId(); }
-private:
-  cardsuit_t m_id;
-  char* m_name;
-  wxBitmap m_bitmap;
+  CardArt();
+  static CardArt* instance;
+  wxBitmap m_cards[N_CARDS];
+  wxBitmap m_face;
+  wxBitmap m_suits[N_SUITS];
 };
 
 // Cards
+// The rules engine only knows card ids, whose suit, type, value and names
+// come from the compile-time tables in corecards.hpp. A Card adds what the
+// GUI needs to show one.
 class Card
 {
 public:
-  Card( Deck *deck, CardType& type, CardSuit& suit, char* xpmdata[] );
+  Card( Deck *deck, cardid_t id );
+  cardid_t GetId() const { return m_id; }
+  Deck* GetDeck() const { return m_deck; }
   wxString NameStr();
   wxString ShortStr();
   bool GetTurned() { return m_turned; }
   void SetTurned( bool turned=true ) { m_turned = turned; }
   bool IsPlayable() const { return m_playable; }
   void SetPlayable( bool playable=true ) { m_playable = playable; }
-  CardSuit& GetSuit() const { return (CardSuit&)m_suit; }
-  CardType& GetType() const { return (CardType&)m_type; }
+  cardsuit_t GetSuit() const { return CardIdSuit( m_id ); }
+  cardtype_t GetType() const { return CardIdType( m_id ); }
   bool HitTest( const wxPoint& pt ) const;
   bool Draw( wxDC& dc );
   wxPoint GetPosition() const { return m_pos; }
   void SetPosition( const wxPoint& pos ) { m_pos = pos; }
-  wxRect GetRect() const { return wxRect( m_pos.x, m_pos.y, m_bitmap.GetWidth(), m_bitmap.GetHeight() ); }
-  wxBitmap& GetBitmap() const { return (wxBitmap&)m_bitmap; }
+  wxRect GetRect() const { return wxRect( m_pos.x, m_pos.y, m_bitmap->GetWidth(), m_bitmap->GetHeight() ); }
+  wxBitmap& GetBitmap() const { return (wxBitmap&)*m_bitmap; }
   void ColorInvert( bool inverted = true );
 private:
   Deck *m_deck;
-  CardType m_type;
-  CardSuit m_suit;
+  cardid_t m_id;
   bool m_turned;
   bool m_playable;
-  wxBitmap m_bitmap;
+  const wxBitmap* m_bitmap;  // Owned by CardArt
   wxPoint m_pos;
   wxRasterOperationMode blitop;
 };
@@ -113,18 +94,19 @@ WX_DECLARE_LIST( Card, CardList );
 WX_DECLARE_STRING_HASH_MAP( Card*, CardMap );
 
 // Decks
+// Cards are kept in card id order, shuffling is up to the rules engine.
+// Each game has its own cards, but their images come from CardArt.
 class Deck
 {
 public:
   Card* nulcard;
-  Card* cards[40];
+  Card* cards[N_CARDS];
   CardMap cardmap;
   Deck();
   ~Deck();
-  void Shuffle();
-  wxBitmap& GetFace() const { return (wxBitmap&)m_face; }
-private:
-  wxBitmap m_face;
+  Card* GetCard( cardid_t id ) const { return cards[id]; }
+  wxBitmap& GetFace() const { return (wxBitmap&)CardArt::Get().GetFace(); }
+  wxBitmap& GetSuitBitmap( cardsuit_t suit ) const { return (wxBitmap&)CardArt::Get().GetSuitBitmap( suit ); }
 };
 
 #endif  // _CARDS_HPP_
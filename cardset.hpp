@@ -0,0 +1,79 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _CARDSET_HPP_
+#define _CARDSET_HPP_ 1
+
+// Forward declarations
+class CardSet;
+
+#include "corecards.hpp"
+
+// Set of cards as a bit mask, bit n meaning card id n is present.
+// Each suit takes 10 consecutive bits, in ascending rank order.
+typedef unsigned long long cardmask_t;
+#define SUIT_MASK ( (cardmask_t)0x3ff )
+#define ALL_CARDS_MASK ( ( (cardmask_t)1 << N_CARDS ) - 1 )
+// One bit per suit at the given rank
+#define RANK_MASK( rank ) ( (cardmask_t)0x0040100401 << ( rank ) )
+
+class CardSet
+{
+public:
+  CardSet(): m_mask( 0 ) {}
+  explicit CardSet( cardmask_t mask ): m_mask( mask ) {}
+  static CardSet All() { return CardSet( ALL_CARDS_MASK ); }
+  static CardSet Suit( cardsuit_t suit ) { return CardSet( SUIT_MASK << ( suit * N_RANKS ) ); }
+  static CardSet Single( cardid_t id ) { return CardSet( (cardmask_t)1 << id ); }
+  cardmask_t GetMask() const { return m_mask; }
+  bool IsEmpty() const { return m_mask == 0; }
+  unsigned int Count() const { return __builtin_popcountll( m_mask ); }
+  bool Contains( cardid_t id ) const { return ( m_mask >> id ) & 1; }
+  void Add( cardid_t id ) { m_mask |= (cardmask_t)1 << id; }
+  void Remove( cardid_t id ) { m_mask &= ~( (cardmask_t)1 << id ); }
+  void Clear() { m_mask = 0; }
+  CardSet InSuit( cardsuit_t suit ) const { return CardSet( m_mask & Suit( suit ).m_mask ); }
+  bool HasSuit( cardsuit_t suit ) const { return ( m_mask & Suit( suit ).m_mask ) != 0; }
+  // Lowest and highest card ids, the set must not be empty
+  cardid_t First() const { return (cardid_t)__builtin_ctzll( m_mask ); }
+  cardid_t Last() const { return (cardid_t)( 63 - __builtin_clzll( m_mask ) ); }
+  cardid_t PopFirst() { cardid_t id = First(); m_mask &= m_mask - 1; return id; }
+  // Sum of the card values
+  unsigned short Points() const
+  {
+    return 2 * __builtin_popcountll( m_mask & RANK_MASK( QUEEN - TWO ) ) +
+      3 * __builtin_popcountll( m_mask & RANK_MASK( JACK - TWO ) ) +
+      4 * __builtin_popcountll( m_mask & RANK_MASK( KING - TWO ) ) +
+      10 * __builtin_popcountll( m_mask & RANK_MASK( SEVEN - TWO ) ) +
+      11 * __builtin_popcountll( m_mask & RANK_MASK( ACE - TWO ) );
+  }
+  CardSet operator |( const CardSet& other ) const { return CardSet( m_mask | other.m_mask ); }
+  CardSet operator &( const CardSet& other ) const { return CardSet( m_mask & other.m_mask ); }
+  CardSet operator -( const CardSet& other ) const { return CardSet( m_mask & ~other.m_mask ); }
+  CardSet operator ~() const { return CardSet( ~m_mask & ALL_CARDS_MASK ); }
+  CardSet& operator |=( const CardSet& other ) { m_mask |= other.m_mask; return *this; }
+  CardSet& operator &=( const CardSet& other ) { m_mask &= other.m_mask; return *this; }
+  CardSet& operator -=( const CardSet& other ) { m_mask &= ~other.m_mask; return *this; }
+  bool operator ==( const CardSet& other ) const { return m_mask == other.m_mask; }
+  bool operator !=( const CardSet& other ) const { return m_mask != other.m_mask; }
+private:
+  cardmask_t m_mask;
+};
+
+#endif  // _CARDSET_HPP_
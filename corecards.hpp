@@ -0,0 +1,131 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _CORECARDS_HPP_
+#define _CORECARDS_HPP_ 1
+
+// Card definitions shared by the rules engine and the GUI.
+// Nothing here may depend on wxWidgets.
+
+// Card types, in ascending order of strength
+enum cardtype_t { TWO=2, THREE, FOUR, FIVE, SIX, QUEEN, JACK, KING, SEVEN, ACE, UNKNOWN_CARD_TYPE };
+
+// Card suits
+enum cardsuit_t { CLUBS=0, DIAMONDS, SPADES, HEARTS, UNKNOWN_CARD_SUIT };
+#define SUITMIN CLUBS
+#define SUITMAX HEARTS
+
+// Compact card identifiers: suit * N_RANKS + rank, where rank is the
+// position of the card type in strength order (0 for a Two, 9 for an Ace)
+typedef unsigned char cardid_t;
+#define N_SUITS 4
+#define N_RANKS 10
+#define N_CARDS 40
+#define NO_CARD ( (cardid_t)0xff )
+
+// Per card data, computed at compile time and indexed by card id
+struct CardInfo
+{
+  unsigned char suit;   // cardsuit_t
+  unsigned char rank;   // 0 for a Two, 9 for an Ace
+  unsigned char value;  // points of the card
+  char letter;          // short name of the card type
+};
+
+// Card ids fit in 6 bits
+static_assert( N_CARDS <= 64, "card ids must fit in 6 bits" );
+
+constexpr unsigned char card_rank_values[N_RANKS] = { 0, 0, 0, 0, 0, 2, 3, 4, 10, 11 };
+constexpr char card_rank_letters[N_RANKS + 1] = "23456QJK7A";
+constexpr const char* card_rank_names[N_RANKS] = {
+  "Two", "Three", "Four", "Five", "Six", "Queen", "Jack", "King", "Seven", "Ace"
+};
+constexpr const char* card_suit_names[N_SUITS] = {
+  "Clubs", "Diamonds", "Spades", "Hearts"
+};
+
+#define CARD_INFO( id ) \
+  { (unsigned char)( ( id ) / N_RANKS ), (unsigned char)( ( id ) % N_RANKS ), \
+    card_rank_values[( id ) % N_RANKS], card_rank_letters[( id ) % N_RANKS] }
+#define CARD_INFO_SUIT( s ) \
+  CARD_INFO( s * N_RANKS + 0 ), CARD_INFO( s * N_RANKS + 1 ), \
+  CARD_INFO( s * N_RANKS + 2 ), CARD_INFO( s * N_RANKS + 3 ), \
+  CARD_INFO( s * N_RANKS + 4 ), CARD_INFO( s * N_RANKS + 5 ), \
+  CARD_INFO( s * N_RANKS + 6 ), CARD_INFO( s * N_RANKS + 7 ), \
+  CARD_INFO( s * N_RANKS + 8 ), CARD_INFO( s * N_RANKS + 9 )
+constexpr CardInfo card_info[N_CARDS] = {
+  CARD_INFO_SUIT( CLUBS ),
+  CARD_INFO_SUIT( DIAMONDS ),
+  CARD_INFO_SUIT( SPADES ),
+  CARD_INFO_SUIT( HEARTS )
+};
+#undef CARD_INFO_SUIT
+#undef CARD_INFO
+
+constexpr cardid_t MakeCardId( cardsuit_t suit, cardtype_t type )
+{
+  return (cardid_t)( suit * N_RANKS + ( type - TWO ) );
+}
+
+constexpr cardsuit_t CardIdSuit( cardid_t id )
+{
+  return (cardsuit_t)card_info[id].suit;
+}
+
+constexpr int CardIdRank( cardid_t id )
+{
+  return card_info[id].rank;
+}
+
+constexpr cardtype_t CardIdType( cardid_t id )
+{
+  return (cardtype_t)( card_info[id].rank + TWO );
+}
+
+constexpr unsigned short CardIdValue( cardid_t id )
+{
+  return card_info[id].value;
+}
+
+// Names, e.g. "Queen" of "Hearts", or "QH"
+constexpr const char* CardIdName( cardid_t id )
+{
+  return card_rank_names[card_info[id].rank];
+}
+
+constexpr const char* CardIdSuitName( cardid_t id )
+{
+  return card_suit_names[card_info[id].suit];
+}
+
+constexpr char CardIdLetter( cardid_t id )
+{
+  return card_info[id].letter;
+}
+
+constexpr char CardIdSuitLetter( cardid_t id )
+{
+  return card_suit_names[card_info[id].suit][0];
+}
+
+// The tables fold at compile time
+static_assert( CardIdValue( MakeCardId( HEARTS, ACE ) ) == 11, "card values" );
+static_assert( CardIdSuit( MakeCardId( SPADES, SEVEN ) ) == SPADES, "card suits" );
+
+#endif  // _CORECARDS_HPP_
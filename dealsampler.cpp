@@ -0,0 +1,172 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <cstring>  // For memset() and memcpy()
+#include "dealsampler.hpp"
+
+// Binomial coefficients up to a whole suit
+struct BinomialTable
+{
+  uint64_t c[N_RANKS + 1][N_RANKS + 1];
+  constexpr BinomialTable(): c()
+  {
+    for( int n = 0; n <= N_RANKS; n++ ) {
+      c[n][0] = 1;
+      for( int k = 1; k <= n; k++ )
+        c[n][k] = c[n - 1][k - 1] + c[n - 1][k];
+    }
+  }
+};
+
+static constexpr BinomialTable binomials;
+
+// Deal sampler implementation
+uint64_t DealSampler::Setup( const CardSet* hands, CardSet unseen, const int* room,
+                             const bool voids[N_SEATS][N_SUITS] )
+{
+  m_count = 0;
+  int n = 0;
+  int total = 0;
+  for( int seat = 0; seat < N_SEATS; seat++ ) {
+    m_known[seat] = hands[seat];
+    if( room[seat] < 0 || room[seat] > MAX_CARDS )
+      return 0;
+    if( !room[seat] )
+      continue;
+    if( n == SAMPLER_SEATS )
+      return 0;
+    m_seats[n] = seat;
+    m_room[n] = room[seat];
+    for( int suit = 0; suit < N_SUITS; suit++ )
+      m_voids[n][suit] = voids[seat][suit];
+    total += room[seat];
+    n++;
+  }
+  // Seats left over get nothing
+  for( ; n < SAMPLER_SEATS; n++ ) {
+    m_seats[n] = -1;
+    m_room[n] = 0;
+    for( int suit = 0; suit < N_SUITS; suit++ )
+      m_voids[n][suit] = true;
+  }
+  if( (int)unseen.Count() != total )
+    return 0;
+  for( int suit = 0; suit < N_SUITS; suit++ ) {
+    CardSet cards = unseen.InSuit( (cardsuit_t)suit );
+    m_ncards[suit] = 0;
+    while( !cards.IsEmpty() )
+      m_cards[suit][m_ncards[suit]++] = cards.PopFirst();
+  }
+  m_unseen[N_SUITS] = 0;
+  for( int suit = N_SUITS - 1; suit >= 0; suit-- )
+    m_unseen[suit] = m_unseen[suit + 1] + m_ncards[suit];
+  // Count from the last suit back
+  memset( m_ways, 0, sizeof( m_ways ) );
+  m_ways[N_SUITS][0][0] = 1;
+  for( int suit = N_SUITS - 1; suit >= 0; suit-- ) {
+    int u = m_ncards[suit];
+    for( int ra = 0; ra <= m_room[0]; ra++ )
+      for( int rb = 0; rb <= m_room[1]; rb++ ) {
+        int rc = m_unseen[suit] - ra - rb;
+        if( rc < 0 || rc > m_room[2] )
+          continue;
+        uint64_t ways = 0;
+        for( int xa = 0; xa <= u && xa <= ra; xa++ ) {
+          if( xa && m_voids[0][suit] )
+            break;
+          for( int xb = 0; xa + xb <= u && xb <= rb; xb++ ) {
+            if( xb && m_voids[1][suit] )
+              break;
+            int xc = u - xa - xb;
+            if( xc > rc || ( xc && m_voids[2][suit] ) )
+              continue;
+            ways += binomials.c[u][xa] * binomials.c[u - xa][xb] *
+              m_ways[suit + 1][ra - xa][rb - xb];
+          }
+        }
+        m_ways[suit][ra][rb] = ways;
+      }
+  }
+  m_count = m_ways[0][m_room[0]][m_room[1]];
+  return m_count;
+}
+
+void DealSampler::Sample( Rng& rng, CardSet* hands ) const
+{
+  for( int seat = 0; seat < N_SEATS; seat++ )
+    hands[seat] = m_known[seat];
+  int ra = m_room[0], rb = m_room[1];
+  for( int suit = 0; suit < N_SUITS; suit++ ) {
+    int u = m_ncards[suit];
+    if( !u )
+      continue;
+    // How many cards of the suit each seat gets, in proportion to the
+    // deals that follow
+    int xa, xb;
+    Split( suit, ra, rb, rng.Below64( m_ways[suit][ra][rb] ), &xa, &xb );
+    // Which cards: the first ones of a random arrangement of the suit
+    cardid_t cards[N_RANKS];
+    memcpy( cards, m_cards[suit], u * sizeof( cardid_t ) );
+    for( int i = 0; i < xa + xb && i < u - 1; i++ ) {
+      int j = i + rng.Below( u - i );
+      cardid_t t = cards[i];
+      cards[i] = cards[j];
+      cards[j] = t;
+    }
+    for( int i = 0; i < u; i++ ) {
+      int slot = i < xa ? 0 : i < xa + xb ? 1 : 2;
+      hands[m_seats[slot]].Add( cards[i] );
+    }
+    ra -= xa;
+    rb -= xb;
+  }
+}
+
+// Cards of a suit the first two seats get in the pick-th split of it,
+// in the order Setup() counted them
+void DealSampler::Split( int suit, int ra, int rb, uint64_t pick, int* xa, int* xb ) const
+{
+  int u = m_ncards[suit];
+  int rc = m_unseen[suit] - ra - rb;
+  for( int a = 0; a <= u && a <= ra; a++ ) {
+    if( a && m_voids[0][suit] )
+      break;
+    for( int b = 0; a + b <= u && b <= rb; b++ ) {
+      if( b && m_voids[1][suit] )
+        break;
+      int c = u - a - b;
+      if( c > rc || ( c && m_voids[2][suit] ) )
+        continue;
+      uint64_t ways = binomials.c[u][a] * binomials.c[u - a][b] *
+        m_ways[suit + 1][ra - a][rb - b];
+      if( pick < ways ) {
+        *xa = a;
+        *xb = b;
+        return;
+      }
+      pick -= ways;
+    }
+  }
+}
+
+void DealSampler::SampleBatch( Rng& rng, CardSet* hands, int n ) const
+{
+  for( int i = 0; i < n; i++ )
+    Sample( rng, hands + i * N_SEATS );
+}
@@ -0,0 +1,69 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _DEALSAMPLER_HPP_
+#define _DEALSAMPLER_HPP_ 1
+
+// Forward declarations
+class DealSampler;
+
+#include <stdint.h>
+#include "engine.hpp"
+#include "rng.hpp"
+
+#define SAMPLER_SEATS 3  // Most seats with cards to deal
+
+// Uniform sampler of the ways to deal the unseen cards, given how many
+// each seat still needs and the suits each seat is known not to have.
+// Deals are counted by suit (the number of cards of each suit every
+// seat gets) and drawn in proportion, so there is no rejection however
+// tight the constraints. One seat at least must be known, as the
+// player's own seat always is.
+class DealSampler
+{
+public:
+  DealSampler(): m_count( 0 ) {}
+  // Hands are the cards known to be in each seat, room the number of
+  // cards still to give to each one. The unseen cards must be as many
+  // as the total room. Returns the number of possible deals, 0 if there
+  // is none or too many seats need cards.
+  uint64_t Setup( const CardSet* hands, CardSet unseen, const int* room,
+                  const bool voids[N_SEATS][N_SUITS] );
+  uint64_t GetCount() const { return m_count; }
+  // Hands of every seat in a deal, all deals being equally likely.
+  // Setup() must have found some.
+  void Sample( Rng& rng, CardSet* hands ) const;
+  // Deals one after the other in a flat array, N_SEATS hands each
+  void SampleBatch( Rng& rng, CardSet* hands, int n ) const;
+private:
+  void Split( int suit, int ra, int rb, uint64_t pick, int* xa, int* xb ) const;
+  CardSet m_known[N_SEATS];
+  cardid_t m_cards[N_SUITS][N_RANKS];  // Unseen, by suit
+  int m_ncards[N_SUITS];
+  int m_unseen[N_SUITS + 1];  // Unseen in this and the next suits
+  int m_seats[SAMPLER_SEATS];  // Getting cards, -1 for none
+  int m_room[SAMPLER_SEATS];
+  bool m_voids[SAMPLER_SEATS][N_SUITS];
+  // Deals of the suits from this one on, by the room left in the first
+  // two seats (the third one gets the rest)
+  uint64_t m_ways[N_SUITS + 1][MAX_CARDS + 1][MAX_CARDS + 1];
+  uint64_t m_count;
+};
+
+#endif  // _DEALSAMPLER_HPP_
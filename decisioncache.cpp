@@ -0,0 +1,193 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <cstdio>
+#include <cstring>
+#include "decisioncache.hpp"
+#include "zobrist.hpp"
+
+// File layout: the magic, the version and the number of entries, then
+// the key, value and card of each entry. Fixed width little endian
+// fields, no padding, so files move between builds and machines.
+#define DECISION_HEADER_BYTES 20
+#define DECISION_RECORD_BYTES 11
+
+static void PutLE( unsigned char* p, uint64_t x, int bytes )
+{
+  for( int i = 0; i < bytes; i++, x >>= 8 )
+    p[i] = (unsigned char)x;
+}
+
+static uint64_t GetLE( const unsigned char* p, int bytes )
+{
+  uint64_t x = 0;
+  for( int i = bytes - 1; i >= 0; i-- )
+    x = x << 8 | p[i];
+  return x;
+}
+
+static const char decisioncache_magic[8] = { 'S', 'U', 'E', 'C', 'A', 'D', 'E', 'C' };
+
+DecisionCache decision_cache;
+
+// Decision cache implementation
+DecisionCache::DecisionCache():
+  m_mask( 0 )
+{
+  memset( &m_stats, 0, sizeof( m_stats ) );
+}
+
+void DecisionCache::Resize( int bits )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_slots.clear();
+  m_hands.clear();
+  m_mask = 0;
+  if( bits > 0 ) {
+    size_t buckets = bits > 2 ? (size_t)1 << ( bits - 2 ) : 1;
+    DecisionEntry empty = { 0, 0, NO_CARD, 0 };
+    m_slots.assign( buckets * DECISION_BUCKET_SLOTS, empty );
+    m_hands.assign( buckets, 0 );
+    m_mask = buckets - 1;
+  }
+  memset( &m_stats, 0, sizeof( m_stats ) );
+}
+
+void DecisionCache::Clear()
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  for( size_t i = 0; i < m_slots.size(); i++ )
+    m_slots[i].key = 0;
+  m_stats.entries = 0;
+}
+
+DecisionEntry* DecisionCache::Find( uint64_t key )
+{
+  DecisionEntry* bucket = &m_slots[( MixBits( key ) & m_mask ) * DECISION_BUCKET_SLOTS];
+  for( int i = 0; i < DECISION_BUCKET_SLOTS; i++ )
+    if( bucket[i].key == key )
+      return &bucket[i];
+  return NULL;
+}
+
+bool DecisionCache::Lookup( uint64_t key, cardid_t* card, int* value )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  if( m_slots.empty() || !key )
+    return false;
+  m_stats.lookups++;
+  DecisionEntry* entry = Find( key );
+  if( !entry )
+    return false;
+  m_stats.hits++;
+  entry->used = 1;
+  *card = entry->card;
+  if( value )
+    *value = entry->value;
+  return true;
+}
+
+void DecisionCache::Store( uint64_t key, cardid_t card, int value )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  if( m_slots.empty() || !key )
+    return;
+  m_stats.stores++;
+  Put( key, card, value );
+}
+
+void DecisionCache::Put( uint64_t key, cardid_t card, int value )
+{
+  DecisionEntry* entry = Find( key );
+  if( !entry ) {
+    // Second chance: the hand skips (and clears) the slots used lately
+    uint64_t n = MixBits( key ) & m_mask;
+    DecisionEntry* bucket = &m_slots[n * DECISION_BUCKET_SLOTS];
+    unsigned char& hand = m_hands[n];
+    for( ;; ) {
+      entry = &bucket[hand];
+      hand = ( hand + 1 ) % DECISION_BUCKET_SLOTS;
+      if( !entry->key || !entry->used )
+        break;
+      entry->used = 0;
+    }
+    if( entry->key )
+      m_stats.evictions++;
+    else
+      m_stats.entries++;
+    entry->key = key;
+  }
+  entry->card = card;
+  entry->value = value;
+  entry->used = 1;
+}
+
+DecisionStats DecisionCache::GetStats()
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  DecisionStats stats = m_stats;
+  stats.slots = m_slots.size();
+  stats.bytes = m_slots.size() * sizeof( DecisionEntry ) + m_hands.size();
+  return stats;
+}
+
+bool DecisionCache::Load( const char* path )
+{
+  FILE* file = fopen( path, "rb" );
+  if( !file )
+    return false;
+  unsigned char buf[DECISION_HEADER_BYTES];
+  bool ok = fread( buf, sizeof( buf ), 1, file ) == 1 &&
+    !memcmp( buf, decisioncache_magic, sizeof( decisioncache_magic ) ) &&
+    GetLE( buf + 8, 4 ) == DECISION_CACHE_VERSION;
+  uint64_t count = ok ? GetLE( buf + 12, 8 ) : 0;
+  std::lock_guard<std::mutex> lock( m_mutex );
+  unsigned char record[DECISION_RECORD_BYTES];
+  for( uint64_t i = 0; ok && i < count; i++ ) {
+    ok = fread( record, sizeof( record ), 1, file ) == 1;
+    uint64_t key = GetLE( record, 8 );
+    if( ok && key && !m_slots.empty() )
+      Put( key, record[10], (short)GetLE( record + 8, 2 ) );
+  }
+  fclose( file );
+  return ok;
+}
+
+bool DecisionCache::Save( const char* path )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  FILE* file = fopen( path, "wb" );
+  if( !file )
+    return false;
+  unsigned char buf[DECISION_HEADER_BYTES];
+  memcpy( buf, decisioncache_magic, sizeof( decisioncache_magic ) );
+  PutLE( buf + 8, DECISION_CACHE_VERSION, 4 );
+  PutLE( buf + 12, m_stats.entries, 8 );
+  bool ok = fwrite( buf, sizeof( buf ), 1, file ) == 1;
+  unsigned char record[DECISION_RECORD_BYTES];
+  for( size_t i = 0; ok && i < m_slots.size(); i++ )
+    if( m_slots[i].key ) {
+      // The use bit only matters to the clock hand of this run
+      PutLE( record, m_slots[i].key, 8 );
+      PutLE( record + 8, (uint16_t)m_slots[i].value, 2 );
+      record[10] = m_slots[i].card;
+      ok = fwrite( record, sizeof( record ), 1, file ) == 1;
+    }
+  return fclose( file ) == 0 && ok;
+}
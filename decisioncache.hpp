@@ -0,0 +1,98 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _DECISIONCACHE_HPP_
+#define _DECISIONCACHE_HPP_ 1
+
+// Forward declarations
+struct DecisionEntry;
+struct DecisionStats;
+class DecisionCache;
+
+#include <stdint.h>
+#include <cstddef>  // For size_t
+#include <mutex>
+#include <vector>
+#include "corecards.hpp"
+
+#define DECISION_CACHE_VERSION 3
+#define DECISION_CACHE_FILE "sueca.cache"
+#define DECISION_CACHE_BITS 16
+#define DECISION_BUCKET_SLOTS 4
+
+// Card a bot chose for an information set
+struct DecisionEntry
+{
+  uint64_t key;  // 0 for an empty slot
+  short value;  // Estimate of the points the bot's team gets of those in play
+  cardid_t card;  // As relabeled in the key
+  unsigned char used;  // Since the clock hand last went by
+};
+
+// Counters for tuning the cache size
+struct DecisionStats
+{
+  uint64_t lookups;
+  uint64_t hits;
+  uint64_t stores;
+  uint64_t evictions;
+  size_t entries;  // Held now
+  size_t slots;
+  size_t bytes;
+};
+
+// Bounded cache of the decisions of the bots, shared by all of them
+// (every seat of every table in the process). Keys are hashes of
+// information sets, what a bot knows when it plays, with the suits
+// relabeled so that the same situation in other suits hits too: each
+// bot makes its own keys, and the cards stored are relabeled the same
+// way.
+// Buckets of DECISION_BUCKET_SLOTS slots, each replacing the slot its
+// clock hand finds unused since it last went by (CLOCK, an LRU
+// approximation). Thread safe, with a single lock: bots only go to it
+// once per move.
+class DecisionCache
+{
+public:
+  DecisionCache();
+  // Room for 2^bits decisions, 0 turns the cache off (the default).
+  // What it held is dropped.
+  void Resize( int bits );
+  bool IsEnabled() const { return !m_slots.empty(); }
+  bool Lookup( uint64_t key, cardid_t* card, int* value );
+  void Store( uint64_t key, cardid_t card, int value );
+  void Clear();
+  DecisionStats GetStats();
+  // Decisions kept between runs, Load() adds them to those held
+  bool Load( const char* path );
+  bool Save( const char* path );
+private:
+  DecisionEntry* Find( uint64_t key );
+  void Put( uint64_t key, cardid_t card, int value );
+  std::mutex m_mutex;
+  std::vector<DecisionEntry> m_slots;
+  std::vector<unsigned char> m_hands;  // Clock hand of every bucket
+  uint64_t m_mask;  // Of the bucket numbers
+  DecisionStats m_stats;
+};
+
+// The cache bots use, off until resized
+extern DecisionCache decision_cache;
+
+#endif  // _DECISIONCACHE_HPP_
@@ -0,0 +1,192 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+// sueca-egtgen: builds the endgame table the solvers look up, offline.
+// Endgames are reached by random play from random deals and solved, along
+// with every position of them whose exact value the search found.
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <vector>
+#include "solver.hpp"
+#include "workpool.hpp"
+
+#define EGTGEN_TABLE_BITS 16  // Plenty for a few tricks
+
+class EgtJob: public PoolJob
+{
+public:
+  EgtJob( int tricks, uint64_t seed, int threads );
+  ~EgtJob();
+  void Run( long item, int worker );
+  // All the workers' entries, in one vector
+  void Collect( std::vector<EndgameEntry>& entries );
+private:
+  int m_tricks;
+  uint64_t m_seed;
+  std::vector<Solver*> m_solvers;  // One per thread, with its own table
+  std::vector< std::vector<EndgameEntry> > m_entries;
+};
+
+EgtJob::EgtJob( int tricks, uint64_t seed, int threads ):
+  m_tricks( tricks ), m_seed( seed ), m_solvers( threads ), m_entries( threads )
+{
+  for( int i = 0; i < threads; i++ ) {
+    m_solvers[i] = new Solver( EGTGEN_TABLE_BITS );
+    m_solvers[i]->SetEndgameTable( NULL );
+  }
+}
+
+EgtJob::~EgtJob()
+{
+  for( size_t i = 0; i < m_solvers.size(); i++ )
+    delete m_solvers[i];
+}
+
+// Plays a whole trick of random legal cards
+static void PlayRandomTrick( Engine& engine, Rng& rng )
+{
+  for( int i = 0; i < N_SEATS; i++ ) {
+    int seat = engine.GetTurn();
+    CardSet moves = Engine::LegalMoves( engine.GetHand( seat ), engine.GetLead() );
+    for( int skip = rng.Below( moves.Count() ); skip > 0; skip-- )
+      moves.PopFirst();
+    engine.PlayMove( seat, moves.First() );
+  }
+  engine.EndTrick();
+}
+
+void EgtJob::Run( long item, int worker )
+{
+  Engine engine;
+  engine.Seed( m_seed ^ ( item * 0x9e3779b97f4a7c15ULL ) );
+  engine.NewGame( item % N_SEATS );
+  engine.NewRound();
+  Rng& rng = engine.GetRng();
+  while( engine.GetTricksLeft() > m_tricks )
+    PlayRandomTrick( engine, rng );
+  // Solve the endgame and what random play leaves of it, down to the
+  // smallest endgames worth a lookup
+  Solver& solver = *m_solvers[worker];
+  TransTable& table = solver.GetTable();
+  std::vector<EndgameEntry>& entries = m_entries[worker];
+  table.Clear();
+  for( ;; ) {
+    GameState state;
+    state.Set( engine );
+    solver.SetPosition( state );
+    EndgameEntry entry;
+    entry.key = state.GetCanonicalHash();
+    entry.value = solver.Solve();
+    entries.push_back( entry );
+    if( engine.GetTricksLeft() <= ENDGAME_MIN_TRICKS )
+      break;
+    PlayRandomTrick( engine, rng );
+  }
+  // Positions met on the way whose bounds met. Without a horizon the
+  // depth is the number of tricks left.
+  for( size_t i = 0; i < table.GetSlots(); i++ ) {
+    EndgameEntry entry;
+    TableEntry found;
+    if( table.GetSlot( i, &entry.key, &found ) && found.lower == found.upper &&
+        found.depth >= ENDGAME_MIN_TRICKS && found.depth <= m_tricks ) {
+      entry.value = found.lower;
+      entries.push_back( entry );
+    }
+  }
+}
+
+void EgtJob::Collect( std::vector<EndgameEntry>& entries )
+{
+  for( size_t i = 0; i < m_entries.size(); i++ ) {
+    entries.insert( entries.end(), m_entries[i].begin(), m_entries[i].end() );
+    std::vector<EndgameEntry>().swap( m_entries[i] );
+  }
+}
+
+static void Usage()
+{
+  fprintf( stderr,
+           "Usage: sueca-egtgen [options] [file]\n"
+           "Solves random endgames and writes their values to file (default " ENDGAME_FILE ").\n"
+           "Options:\n"
+           "  -k TRICKS     tricks left in the endgames (default 4)\n"
+           "  -n DEALS      number of endgames to solve (default 100000)\n"
+           "  -t THREADS    worker threads (default: one per core)\n"
+           "  -s SEED       random seed (default: random)\n" );
+}
+
+int main( int argc, char** argv )
+{
+  int tricks = 4;
+  long deals = 100000;
+  int threads = 0;
+  uint64_t seed = Rng::RandomSeed();
+  const char* path = ENDGAME_FILE;
+  bool haspath = false;
+  for( int i = 1; i < argc; i++ ) {
+    if( argv[i][0] == '-' && argv[i][1] && !argv[i][2] && i + 1 < argc ) {
+      const char* value = argv[++i];
+      switch( argv[i - 1][1] ) {
+      case 'k':
+        tricks = atoi( value );
+        continue;
+      case 'n':
+        deals = atol( value );
+        continue;
+      case 't':
+        threads = atoi( value );
+        continue;
+      case 's':
+        seed = strtoull( value, NULL, 0 );
+        continue;
+      }
+    }
+    else if( argv[i][0] != '-' && !haspath ) {
+      path = argv[i];
+      haspath = true;
+      continue;
+    }
+    Usage();
+    return 1;
+  }
+  if( tricks < ENDGAME_MIN_TRICKS || tricks > MAX_CARDS || deals <= 0 ) {
+    Usage();
+    return 1;
+  }
+
+  WorkPool pool( threads );
+  EgtJob job( tricks, seed, pool.GetThreads() );
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  pool.Run( job, deals );
+  std::vector<EndgameEntry> entries;
+  job.Collect( entries );
+  size_t found = entries.size();
+  if( !EndgameTable::Write( path, tricks, entries ) ) {
+    fprintf( stderr, "Could not write %s\n", path );
+    return 1;
+  }
+  double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+  printf( "%ld endgames of %d tricks, %d threads, seed %llu\n", deals, tricks,
+          pool.GetThreads(), (unsigned long long)seed );
+  printf( "%lu positions (%lu solved more than once) written to %s in %.2f s\n",
+          (unsigned long)entries.size(), (unsigned long)( found - entries.size() ), path, seconds );
+  return 0;
+}
@@ -0,0 +1,120 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>  // For sort()
+#include "endgame.hpp"
+
+struct EndgameHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t maxtricks;
+  uint64_t count;
+};
+
+static const char endgame_magic[8] = { 'S', 'U', 'E', 'C', 'A', 'E', 'G', 'T' };
+
+EndgameTable endgame_table;
+
+// Endgame table implementation
+EndgameTable::EndgameTable():
+  m_keys( NULL ), m_values( NULL ), m_count( 0 ), m_maxtricks( 0 )
+{
+}
+
+bool EndgameTable::Open( const char* path )
+{
+  Close();
+  if( !m_file.Open( path ) )
+    return false;
+  // Refuse files of other versions or cut short
+  const EndgameHeader* header = (const EndgameHeader*)m_file.GetData();
+  if( m_file.GetSize() < sizeof( EndgameHeader ) ||
+      memcmp( header->magic, endgame_magic, sizeof( endgame_magic ) ) ||
+      header->version != ENDGAME_VERSION ||
+      header->count > ( m_file.GetSize() - sizeof( EndgameHeader ) ) / ( sizeof( uint64_t ) + 1 ) ) {
+    m_file.Close();
+    return false;
+  }
+  m_count = header->count;
+  m_maxtricks = header->maxtricks;
+  m_keys = (const uint64_t*)( header + 1 );
+  m_values = (const unsigned char*)( m_keys + m_count );
+  return true;
+}
+
+void EndgameTable::Close()
+{
+  m_file.Close();
+  m_keys = NULL;
+  m_values = NULL;
+  m_count = 0;
+  m_maxtricks = 0;
+}
+
+// Keys are hashes, spread evenly, so the search guesses where the key
+// should be instead of halving the range: a few probes instead of log2(n)
+bool EndgameTable::Lookup( uint64_t key, int* value ) const
+{
+  size_t low = 0, high = m_count;  // The key can only be in [low, high)
+  while( low < high ) {
+    uint64_t first = m_keys[low];
+    uint64_t last = m_keys[high - 1];
+    if( key < first || key > last )
+      return false;
+    size_t guess = low + (size_t)( (double)( key - first ) / ( (double)( last - first ) + 1.0 ) * ( high - low ) );
+    if( guess >= high )
+      guess = high - 1;
+    if( m_keys[guess] < key )
+      low = guess + 1;
+    else if( m_keys[guess] > key )
+      high = guess;
+    else {
+      *value = m_values[guess];
+      return true;
+    }
+  }
+  return false;
+}
+
+bool EndgameTable::Write( const char* path, int maxtricks, std::vector<EndgameEntry>& entries )
+{
+  std::sort( entries.begin(), entries.end() );
+  size_t n = 0;
+  for( size_t i = 0; i < entries.size(); i++ )
+    if( n == 0 || entries[i].key != entries[n - 1].key )
+      entries[n++] = entries[i];
+  entries.resize( n );
+  FILE* file = fopen( path, "wb" );
+  if( !file )
+    return false;
+  EndgameHeader header;
+  memcpy( header.magic, endgame_magic, sizeof( endgame_magic ) );
+  header.version = ENDGAME_VERSION;
+  header.maxtricks = maxtricks;
+  header.count = n;
+  bool ok = fwrite( &header, sizeof( header ), 1, file ) == 1;
+  for( size_t i = 0; ok && i < n; i++ )
+    ok = fwrite( &entries[i].key, sizeof( uint64_t ), 1, file ) == 1;
+  for( size_t i = 0; ok && i < n; i++ )
+    ok = fputc( entries[i].value, file ) != EOF;
+  return fclose( file ) == 0 && ok;
+}
@@ -0,0 +1,76 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _ENDGAME_HPP_
+#define _ENDGAME_HPP_ 1
+
+// Forward declarations
+struct EndgameEntry;
+class EndgameTable;
+
+#include <stdint.h>
+#include <cstddef>  // For size_t
+#include <vector>
+#include "mappedfile.hpp"
+
+// Changes whenever canonical hashes do, older files are refused
+#define ENDGAME_VERSION 2
+#define ENDGAME_FILE "sueca.egt"
+// The solver plays out the last two tricks directly, without a lookup
+#define ENDGAME_MIN_TRICKS 3
+
+// Exact value of an endgame: the points team 0 gets from the cards still
+// in play, keyed by the canonical hash of the position (between tricks)
+struct EndgameEntry
+{
+  uint64_t key;
+  unsigned char value;
+  bool operator <( const EndgameEntry& other ) const { return key < other.key; }
+};
+
+// Read only table of solved endgames, made offline by sueca-egtgen and
+// mapped in memory.
+// File layout: a header, the sorted keys, then the values in the same
+// order (native byte order).
+// Lookups are thread safe once the table is open.
+class EndgameTable
+{
+public:
+  EndgameTable();
+  bool Open( const char* path );
+  void Close();
+  bool IsOpen() const { return m_file.IsOpen(); }
+  // Positions with up to this many tricks left may be in the table
+  int GetMaxTricks() const { return m_maxtricks; }
+  size_t GetCount() const { return m_count; }
+  bool Lookup( uint64_t key, int* value ) const;
+  // Entries get sorted, duplicate keys are dropped
+  static bool Write( const char* path, int maxtricks, std::vector<EndgameEntry>& entries );
+private:
+  MappedFile m_file;
+  const uint64_t* m_keys;
+  const unsigned char* m_values;
+  size_t m_count;
+  int m_maxtricks;
+};
+
+// The table solvers look at by default, open it before they start
+extern EndgameTable endgame_table;
+
+#endif  // _ENDGAME_HPP_
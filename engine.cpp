@@ -0,0 +1,172 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <cstdlib>  // For abs()
+#include "engine.hpp"
+#include "trick.hpp"
+
+// Rules engine implementation
+Engine::Engine( EngineObserver* observer ):
+  m_observer( observer )
+{
+  for( int i = 0; i < N_CARDS; i++ )
+    m_deck[i] = (cardid_t)i;
+  NewGame( 0 );
+}
+
+void Engine::NewGame( int dealer )
+{
+  m_dealer = dealer;
+  m_trumph = NO_CARD;
+  m_trumph_owner = dealer;
+  m_leader = m_turn = ( dealer + 1 ) % N_SEATS;
+  m_nplayed = 0;
+  m_tricks_left = 0;
+  for( int seat = 0; seat < N_SEATS; seat++ )
+    m_hands[seat].Clear();
+  for( int team = 0; team < 2; team++ ) {
+    m_captured[team].Clear();
+    m_won[team] = 0;
+  }
+  m_multiplier = 1;
+}
+
+void Engine::Shuffle()
+{
+  m_rng.Shuffle( m_deck, N_CARDS );
+}
+
+void Engine::NewRound()
+{
+  Shuffle();
+  // The dealer's right gets the first hand, the dealer gets the last one
+  // and keeps its last card as the trumph
+  int n = 0;
+  for( int p = 1; p <= N_SEATS; p++ ) {
+    int seat = ( m_dealer + p ) % N_SEATS;
+    m_hands[seat].Clear();
+    for( int i = 0; i < MAX_CARDS; i++ )
+      m_hands[seat].Add( m_deck[n++] );
+  }
+  StartRound( m_deck[N_CARDS - 1], m_dealer );
+}
+
+// Also used directly when the hands are dealt elsewhere (network clients)
+void Engine::StartRound( cardid_t trumph, int owner )
+{
+  m_trumph = trumph;
+  m_trumph_owner = owner;
+  m_dealer = m_leader = m_turn = ( owner + 1 ) % N_SEATS;
+  m_nplayed = 0;
+  m_tricks_left = MAX_CARDS;
+  for( int team = 0; team < 2; team++ )
+    m_captured[team].Clear();
+  if( m_observer )
+    m_observer->OnNewRound( m_trumph, m_trumph_owner );
+}
+
+movestatus_t Engine::PlayMove( int seat, cardid_t card )
+{
+  if( seat != m_turn || IsTrickComplete() || IsRoundOver() )
+    return MOVE_TURN;  // Not this seat's turn
+  if( !IsValidMove( seat, card ) )
+    return MOVE_INVALID;
+  ForceMove( seat, card );
+  return MOVE_OK;
+}
+
+// Play a card without checking it, for moves already validated elsewhere
+// (e.g. by a game server). The card need not be in the known hand.
+void Engine::ForceMove( int seat, cardid_t card )
+{
+  m_hands[seat].Remove( card );
+  m_played[m_nplayed++] = card;
+  m_turn = ( seat + 1 ) % N_SEATS;
+  if( m_observer )
+    m_observer->OnPlay( seat, card );
+}
+
+int Engine::EndTrick()
+{
+  int winner = TurnWinner();
+  CardSet& captured = m_captured[TeamOf( winner )];
+  for( int i = 0; i < m_nplayed; i++ )
+    captured.Add( m_played[i] );
+  m_nplayed = 0;
+  m_leader = m_turn = winner;
+  m_tricks_left--;
+  if( m_observer )
+    m_observer->OnTrickEnd( winner );
+  return winner;
+}
+
+void Engine::EndRound()
+{
+  int winteam;
+  unsigned short victories = CalcWonGames( &winteam );
+  if( m_observer )
+    m_observer->OnRoundEnd( winteam, victories );
+}
+
+bool Engine::IsValidMove( int seat, cardid_t card ) const
+{
+  return IsLegal( m_hands[seat], card, GetLead() );
+}
+
+// Cards of a hand that can be played on a trick led by the given card
+// (NO_CARD when leading)
+CardSet Engine::LegalMoves( CardSet hand, cardid_t lead )
+{
+  if( lead == NO_CARD )
+    return hand;  // First to play
+  CardSet follow = hand.InSuit( CardIdSuit( lead ) );
+  return follow.IsEmpty() ? hand : follow;
+}
+
+// The trick must be complete
+int Engine::TurnWinner() const
+{
+  int winner = TrickWinner( m_played, CardIdSuit( m_played[0] ), CardIdSuit( m_trumph ) );
+  return ( m_leader + winner ) % N_SEATS;
+}
+
+// Returns the victories won by the round winner, and sets winteam
+// to the winner team or -1 in case of a tie
+unsigned short Engine::CalcWonGames( int* winteam )
+{
+  int dif = GetRoundPoints( 0 ) - GetRoundPoints( 1 );
+  if( dif == 0 ) {  // Tied game
+    m_multiplier *= 2;
+    *winteam = -1;
+    return 0;
+  }
+  int winner = dif > 0 ? 0 : 1;
+  unsigned short victories;
+  if( m_captured[winner].Count() == N_CARDS )
+    victories = 4;
+  else if( abs( dif ) > 60 )
+    victories = 2;
+  else
+    victories = 1;
+  victories *= m_multiplier;
+  m_won[winner] += victories;
+  m_multiplier = 1;
+  *winteam = winner;
+  return victories;
+}
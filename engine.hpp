@@ -0,0 +1,114 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _ENGINE_HPP_
+#define _ENGINE_HPP_ 1
+
+// Forward declarations
+class EngineObserver;
+class Engine;
+
+#include <cstddef>  // For NULL
+#include "corecards.hpp"
+#include "cardset.hpp"
+#include "rng.hpp"
+
+#ifndef MAX_CARDS
+#define MAX_CARDS 10
+#endif  // MAX_CARDS
+#define N_SEATS 4
+
+// Result of trying to play a card
+enum movestatus_t { MOVE_OK, MOVE_TURN, MOVE_INVALID, MOVE_DELAYED };
+
+// Interface for whoever needs to follow a game (GUI, network, statistics)
+// Callbacks are made after the engine state has been updated
+class EngineObserver
+{
+public:
+  virtual ~EngineObserver() {}
+  virtual void OnNewRound( cardid_t trumph, int owner ) {}
+  virtual void OnPlay( int seat, cardid_t card ) {}
+  virtual void OnTrickEnd( int winner ) {}
+  virtual void OnRoundEnd( int winteam, unsigned short victories ) {}
+};
+
+// Headless Sueca rules engine
+// Seats are numbered 0 to 3 in playing order. Seats 0 and 2 are team 0,
+// seats 1 and 3 are team 1.
+class Engine
+{
+public:
+  Engine( EngineObserver* observer = NULL );
+  void SetObserver( EngineObserver* observer ) { m_observer = observer; }
+  static int TeamOf( int seat ) { return seat & 1; }
+  // Random numbers of this game only, seed it to replay the same deals
+  void Seed( uint64_t seed ) { m_rng.Seed( seed ); }
+  Rng& GetRng() { return m_rng; }
+  // Game flow
+  void NewGame( int dealer );
+  void NewRound();
+  void StartRound( cardid_t trumph, int owner );
+  movestatus_t PlayMove( int seat, cardid_t card );
+  void ForceMove( int seat, cardid_t card );
+  int EndTrick();
+  void EndRound();
+  // Rules
+  bool IsValidMove( int seat, cardid_t card ) const;
+  static CardSet LegalMoves( CardSet hand, cardid_t lead );
+  static bool IsLegal( CardSet hand, cardid_t card, cardid_t lead )
+    { return LegalMoves( hand, lead ).Contains( card ); }
+  int TurnWinner() const;
+  unsigned short CalcWonGames( int* winteam );
+  // State
+  int GetTurn() const { return m_turn; }
+  int GetLeader() const { return m_leader; }
+  cardid_t GetTrumph() const { return m_trumph; }
+  int GetTrumphOwner() const { return m_trumph_owner; }
+  unsigned short GetPlayedCount() const { return m_nplayed; }
+  cardid_t GetPlayed( int i ) const { return m_played[i]; }
+  cardid_t GetLead() const { return m_nplayed ? m_played[0] : NO_CARD; }
+  bool IsTrickComplete() const { return m_nplayed == N_SEATS; }
+  bool IsRoundOver() const { return m_tricks_left == 0; }
+  unsigned short GetTricksLeft() const { return m_tricks_left; }
+  CardSet GetHand( int seat ) const { return m_hands[seat]; }
+  unsigned short GetHandCount( int seat ) const { return m_hands[seat].Count(); }
+  unsigned short GetRoundPoints( int team ) const { return m_captured[team].Points(); }
+  CardSet GetCaptured( int team ) const { return m_captured[team]; }
+  unsigned short GetWon( int team ) const { return m_won[team]; }
+protected:
+  void Shuffle();
+  EngineObserver* m_observer;
+  Rng m_rng;
+  cardid_t m_deck[N_CARDS];
+  CardSet m_hands[N_SEATS];
+  cardid_t m_played[N_SEATS];  // Current trick, starting with the leader
+  unsigned short m_nplayed;
+  int m_leader;
+  int m_turn;
+  int m_dealer;  // Next trumph owner
+  cardid_t m_trumph;
+  int m_trumph_owner;
+  unsigned short m_tricks_left;
+  CardSet m_captured[2];
+  unsigned short m_won[2];
+  unsigned short m_multiplier;  // Victory multiplier (for ties)
+};
+
+#endif  // _ENGINE_HPP_
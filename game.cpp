@@ -17,7 +17,6 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 */
 
-#include <cstdlib>  // For abs()
 #include "game.hpp"
 #include "main.hpp"
 
@@ -131,30 +130,27 @@ void EndTurnTimer::Notify()
   m_game->EndTurn();
 }
 
-// Game engine class implementation
-Game* Game::running = NULL;
-
+// Game class implementation
 Game::Game( Player* p1,
 	    Player* p2,
 	    Player* p3,
 	    Player* p4,
 	    MyCanvas *the_canvas ):
-  canvas( the_canvas ), m_trumph( NULL ),
+  canvas( the_canvas ), m_engine( this ), m_trumph( NULL ),
   trumph_owner( NULL ), m_cards_to_collect( 0 ), m_endturntimer( this ),
-  playtime( false )
+  playtime( false ), m_ticket( 0 ), m_ready( NO_CARD )
 {
-  // Make sure only one instance of a game will run at a time
-  if( running )
-    delete running;
-  running = this;
   m_players = new PlayerIterator( p1, p2, p3, p4 );
-  m_roundpos = new PlayerIterator( *m_players );
-  team1 = new Team( (*m_players)[0], (*m_players)[2] );
-  team2 = new Team( (*m_players)[1], (*m_players)[3] );
+  for( int i = 0; i < N_SEATS; i++ )
+    m_seats[i] = (*m_players)[i];
+  team1 = new Team( m_seats[0], m_seats[2] );
+  team2 = new Team( m_seats[1], m_seats[3] );
+  // Every game has its own random sequence
+  m_engine.Seed( Rng::RandomSeed() );
   // Set a random player to have the trumph at the first round
   // Note that the first to play will be the one at his right
-  int first = (int)( 4.0 * rand() / ( RAND_MAX + 1.0 ) );
-  m_roundpos->SetCurrent( first );
+  int first = m_engine.GetRng().Below( 4 );
+  m_engine.NewGame( first );
   // Score dialog
   MyFrame* frame = wxGetApp().GetFrame();
   score = new ScoreDialog( frame, team1, team2, frame->score_pos );
@@ -178,7 +174,6 @@ Game::~Game()
 {
   delete team1;
   delete team2;
-  delete m_roundpos;
   Player* first, *player;
   first = player = m_players->GetCurrent();
   do {
@@ -197,32 +192,20 @@ Game::~Game()
   // Sane window closing
   score->Close( TRUE );
   trumphdlg->Close( TRUE );
-  running = NULL;
 }
 
+int Game::SeatOf( Player* player ) const
+{
+  for( int i = 0; i < N_SEATS; i++ )
+    if( m_seats[i] == player )
+      return i;
+  return -1;
+}
+
+// Safe to call anytime during a turn (e.g. within a bot player)
 Player* Game::TurnWinner()
 {
-  CardList::Node* node = m_played.GetFirst();
-  Card* biggest = node->GetData();
-  Player* current;
-  Player* winner;
-  current = winner = m_players->GetCurrent();
-  while( ( node = node->GetNext() ) != NULL ) {
-    Card* card = node->GetData();
-    Player* player = m_players->GetNext();
-    if( ( card->GetSuit() == m_trumph->GetSuit() &&
-          ( biggest->GetSuit() != m_trumph->GetSuit() ||
-            card->GetType() > biggest->GetType() ) ) ||
-        ( card->GetSuit() == biggest->GetSuit() &&
-          card->GetType() > biggest->GetType() ) ) {
-          biggest = card;
-          winner = player;
-    }
-  }
-  // Ensure the iterator is restored to its initial state,
-  // so it's safe to call this method anytime (e.g. within a bot player)
-  m_players->SetCurrent( current );
-  return winner;
+  return m_seats[m_engine.TurnWinner()];
 }
 
 void Game::CardMoved( Card* card )
@@ -237,28 +220,36 @@ void Game::CardMoved( Card* card )
 
 void Game::NewRound()
 {
-  turns_left = 10;
-  m_deck.Shuffle();
-  int n = 0;
-  for( int p = 1; p <= 4; p++ ) {
-    Player* pl = m_roundpos->GetNext();
-    for( int i = 0; i < MAX_CARDS; i++ )
-      pl->AddToHand( m_deck.cards[n++], canvas );
+  m_engine.NewRound();
+  PassTurn();
+}
+
+void Game::OnNewRound( cardid_t trumph, int owner )
+{
+  // Hand over the dealt cards, starting at the trumph owner's right
+  for( int p = 1; p <= N_SEATS; p++ ) {
+    int seat = ( owner + p ) % N_SEATS;
+    for( CardSet hand = m_engine.GetHand( seat ); !hand.IsEmpty(); )
+      m_seats[seat]->AddToHand( m_deck.GetCard( hand.PopFirst() ), canvas );
   }
-  m_trumph = m_deck.cards[39];
+  m_trumph = m_deck.GetCard( trumph );
   // Each team instance tells its players a new round is starting
-  trumph_owner = m_roundpos->GetCurrent();
+  trumph_owner = m_seats[owner];
   team1->NewRound( m_trumph, trumph_owner );
   team2->NewRound( m_trumph, trumph_owner );
   canvas->SetTrumphLabel( trumph_owner, m_trumph );
   trumphdlg->UpdateTrumph( m_trumph, trumph_owner );
-  Player* first = m_roundpos->GetNext();
-  PassTurn( first );
+  RequestMove();
 }
 
 void Game::EndTurn()
 {
-  Player* winner = TurnWinner();
+  m_engine.EndTrick();
+}
+
+void Game::OnTrickEnd( int seat )
+{
+  Player* winner = m_seats[seat];
   winner->GetTeam()->AddToCapt( m_played );
   score->UpdateRoundResults();
   // Inform players about the outcome (mainly for bot AI and network clients)
@@ -269,120 +260,139 @@ void Game::EndTurn()
   CardList::Node* node = m_played.GetFirst();
   while( node ) {
     // Add events
-    canvas->MoveCardTo( node->GetData(), winner->GetCollectPos() );
+    canvas->MoveCardTo( node->GetData(), winner->GetCollectPos(), this );
     node = node->GetNext();
   }
   m_played.Clear();
-  turns_left--;
-  m_players->SetCurrent( winner );
+  // The winner leads while the cards are collected
+  if( !m_engine.IsRoundOver() )
+    RequestMove();
 }
 
 const wxString tiedstr( "(T)" );
 
-unsigned short Game::CalcWonGames( Team** win )
+void Game::OnRoundEnd( int winteam, unsigned short victories )
 {
-  static short multiplier = 1;  // Victory multiplier (for ties)
-  int dif = team1->GetRoundPoints() - team2->GetRoundPoints();
-  if( dif == 0 ) {  // Tied game
-    multiplier *= 2;
+  // Update scores, show results
+  wxString showstr;
+  if( winteam < 0 ) {
     team1->SetWonStr( tiedstr );
     team2->SetWonStr( tiedstr );
-    *win = NULL;
-    return 0;
-  }
-  Team *winner, *loser;
-  if( dif > 0 ) {
-    winner = team1;
-    loser = team2;
+    showstr = wxString( "Last Round: tied" );
   }
   else {
-    winner = team2;
-    loser = team1;
+    Team *winner, *loser;
+    if( winteam == 0 ) {
+      winner = team1;
+      loser = team2;
+    }
+    else {
+      winner = team2;
+      loser = team1;
+    }
+    winner->AddToWon( victories );
+    winner->SetWonStr( wxString::Format( "(%hu)", victories ) );
+    loser->SetWonStr( "" );
+    showstr = wxString::Format( "Last Round: %hu for %s/%s", victories,
+                                winner->GetP1()->GetName().c_str(),
+                                winner->GetP2()->GetName().c_str() );
   }
-  unsigned short victories;
-  if( winner->GetCapt().GetCount() == 40 )
-    victories = 4;
-  else if( abs( dif ) > 60 )
-    victories = 2;
-  else
-    victories = 1;
-  victories *= multiplier;
-  winner->AddToWon( victories );
-  winner->SetWonStr( wxString::Format( "(%hu)", victories ) );
-  loser->SetWonStr( "" );
-  multiplier = 1;
-  *win = winner;
-  return victories;
+  wxGetApp().GetFrame()->SetStatusText( showstr, 1 );
+  score->SetEndRoundResults();
 }
 
-void Game::PassTurn( Player *player )
+void Game::PassTurn()
 {
-  if( turns_left == 0 ) {
-    // Update scores, show results
-    Team* winner;
-    wxString showstr;
-    unsigned short vict;
-    if( ( vict = CalcWonGames( &winner ) ) == 0 )
-      showstr = wxString( "Last Round: tied" );
-    else
-      showstr = wxString::Format( "Last Round: %hu for %s/%s", vict,
-                                   winner->GetP1()->GetName().c_str(),
-                                   winner->GetP2()->GetName().c_str() );
-    wxGetApp().GetFrame()->SetStatusText( showstr, 1 );
-    score->SetEndRoundResults();
+  if( m_engine.IsRoundOver() ) {
+    m_engine.EndRound();
     NewRound();
     return;
   }
-  if( m_played.GetCount() == 4 ) {
+  if( m_engine.IsTrickComplete() ) {
     // Wait some time before collecting the cards
     // The 'while' is to ensure the timer starts
     while( ! m_endturntimer.Start( 750, wxTIMER_ONE_SHOT ) );
     return;
   }
-  if( player )
-    m_players->SetCurrent( player );
-  else
-    player = m_players->GetCurrent();
-
   playtime = true;
-  player->OnMyTurn( this, m_played );
+  m_seats[m_engine.GetTurn()]->OnMyTurn( this, m_played );
+  if( m_ready != NO_CARD )
+    PlayReady();
+}
+
+void Game::RequestMove()
+{
+  m_ready = NO_CARD;
+  Player* player = m_seats[m_engine.GetTurn()];
+  player->OnMoveRequest( this, m_played, ++m_ticket );
+  // A bot next in the trick thinks ahead while a human decides (a bot
+  // thinking already has the cores busy)
+  if( !player->IsBot() && m_engine.GetPlayedCount() < N_SEATS - 1 )
+    m_seats[( m_engine.GetTurn() + 1 ) % N_SEATS]->OnPonder( this, m_played );
+}
+
+void Game::MoveReady( Player* player, unsigned int ticket, cardid_t card )
+{
+  // Late answers, e.g. from a replaced player, are dropped
+  if( ticket != m_ticket || player != m_seats[m_engine.GetTurn()] )
+    return;
+  m_ready = card;
+  if( playtime )
+    PlayReady();
+}
+
+void Game::PlayReady()
+{
+  int seat = m_engine.GetTurn();
+  cardid_t card = m_ready;
+  m_ready = NO_CARD;
+  // Asking a bot again for a card the engine refuses could go on
+  // forever, so the first legal card is played instead
+  if( card == NO_CARD || !m_engine.IsValidMove( seat, card ) )
+    card = Engine::LegalMoves( m_engine.GetHand( seat ), m_engine.GetLead() ).First();
+  PlayMove( m_seats[seat], m_deck.GetCard( card ) );
 }
 
 movestatus_t Game::PlayMove( Player *player, Card *card )
 {
-  if( !playtime || player != m_players->GetCurrent() )
+  if( !playtime )
     return MOVE_TURN;  // Not this player's turn
-  if( !player->IsValidMove( card, m_played ) )
-    return MOVE_INVALID;  // Invalid move
+  return m_engine.PlayMove( SeatOf( player ), card->GetId() );
+}
+
+void Game::OnPlay( int seat, cardid_t id )
+{
+  Player* player = m_seats[seat];
+  Card* card = m_deck.GetCard( id );
   // Tell players which card was played, including this one for confirmation
   // (mainly for network games)
   for( int i = 0; i < 4; i++ )
     m_players->GetNext()->Turn( player, card );
-  // Play the move
+  // Show the move
   m_played.Append( card );
   player->Remove( card );
   card->SetPlayable( false );
   card->SetTurned( false );
   playtime = false;
-  canvas->MoveCardTo( card, player->GetPlayPos() );
-  m_players->GetNext();
-  return MOVE_OK;
+  canvas->MoveCardTo( card, player->GetPlayPos(), this );
+  // The next seat thinks while the card moves
+  if( !m_engine.IsTrickComplete() )
+    RequestMove();
 }
 
 bool Game::ReplacePlayer( Player* oldplayer, Player* newplayer )
 {
   if( m_players->Replace( oldplayer, newplayer ) ) {
-    m_roundpos->Replace( oldplayer, newplayer );
+    m_seats[SeatOf( oldplayer )] = newplayer;
     oldplayer->GetTeam()->Replace( oldplayer, newplayer );
     newplayer->NewGame( this );
-    CardList& newhand = newplayer->GetHand();
-    for( CardList::Node* node = oldplayer->GetHand().GetFirst();
-	 node;
-	 node = node->GetNext() )
-      newhand.Append( node->GetData() );
+    newplayer->SetHand( oldplayer->GetHand() );
     newplayer->NewRound( m_trumph, trumph_owner );
     RefreshNames();
-    if( playtime && m_players->GetCurrent() == newplayer )
+    if( m_seats[m_engine.GetTurn()] == newplayer &&
+        !m_engine.IsTrickComplete() && !m_engine.IsRoundOver() )
+      RequestMove();
+    if( playtime && m_seats[m_engine.GetTurn()] == newplayer )
       newplayer->OnMyTurn( this, m_played );
     return true;
   }
@@ -27,6 +27,7 @@ class EndTurnTimer;
 class Game;
 
 #include <wx/timer.h>
+#include "engine.hpp"
 #include "cards.hpp"
 #include "mycanvas.hpp"
 #include "player.hpp"
@@ -75,9 +76,8 @@ private:
   Game* m_game;
 };
 
-// Game engine class
-enum movestatus_t { MOVE_OK, MOVE_TURN, MOVE_INVALID, MOVE_DELAYED };
-class Game
+// Game class, presents a rules engine game on the GUI
+class Game: public EngineObserver
 {
 public:
   ScoreDialog* score;
@@ -91,27 +91,38 @@ public:
   virtual ~Game();
   Deck& GetDeck() const { return (Deck&)m_deck; }
   PlayerIterator* GetPlayers() { return new PlayerIterator( *m_players ); }
+  const Engine& GetEngine() const { return m_engine; }
   Player* TurnWinner();
   void CardMoved( Card* card );
   virtual void NewRound();
   virtual void EndTurn();
-  unsigned short CalcWonGames( Team** win );
-  void PassTurn( Player* player = NULL );
+  void PassTurn();
   virtual movestatus_t PlayMove( Player *player, Card *card );
+  // Answer to Player::OnMoveRequest
+  void MoveReady( Player* player, unsigned int ticket, cardid_t card );
   CardList& GetPlayed() const { return (CardList&)m_played; }
   Card* GetTrumph() const { return m_trumph; }
   bool ReplacePlayer( Player* oldplayer, Player* newplayer );
   virtual void SetPlayerName( Player* player, const wxString& newname );
   void RefreshNames();
   void DisplayResults();
+  int SeatOf( Player* player ) const;
+  // Engine observer callbacks
+  virtual void OnNewRound( cardid_t trumph, int owner );
+  virtual void OnPlay( int seat, cardid_t card );
+  virtual void OnTrickEnd( int winner );
+  virtual void OnRoundEnd( int winteam, unsigned short victories );
 
 protected:
+  void RequestMove();
+  void PlayReady();
   MyCanvas *canvas;
   // Ensure deck is initialized after the wxApp derived class has started,
   // or wxBitmap objects creation may cause segfaults under wxGTK.
   Deck m_deck;
+  Engine m_engine;
   PlayerIterator *m_players;
-  PlayerIterator *m_roundpos;
+  Player* m_seats[N_SEATS];
   Team *team1;
   Team *team2;
   CardList m_played;
@@ -119,11 +130,12 @@ protected:
   Player* trumph_owner;
   unsigned short m_cards_to_collect;
   EndTurnTimer m_endturntimer;
-  unsigned short turns_left;
   bool playtime;
-
-private:
-  static Game* running;
+  // Move pipeline: the seat to play is asked for its card as soon as the
+  // engine knows it (while the last card may still be moving), and the
+  // card is played once the table is ready for it
+  unsigned int m_ticket;  // Of the last move asked for
+  cardid_t m_ready;  // Card answered before its time, or NO_CARD
 };
 
 #endif // _GAME_HPP_
@@ -0,0 +1,59 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <cstring>  // For memcpy()
+#include "gamestate.hpp"
+#include "canonical.hpp"
+
+// Game state implementation
+void GameState::Set( const CardSet* hands, cardsuit_t trumph, int leader,
+                     const cardid_t* trick, int ntrick, const unsigned short* points )
+{
+  for( int seat = 0; seat < N_SEATS; seat++ )
+    m_hands[seat] = hands[seat];
+  memcpy( m_tricks[0], trick, ntrick * sizeof( cardid_t ) );
+  m_leaders[0] = leader;
+  m_ntricks = 0;
+  m_nplayed = ntrick;
+  m_trumph = trumph;
+  for( int team = 0; team < 2; team++ )
+    m_points[team] = points ? points[team] : 0;
+}
+
+void GameState::Set( const Engine& engine )
+{
+  CardSet hands[N_SEATS];
+  cardid_t trick[N_SEATS];
+  unsigned short points[2];
+  for( int seat = 0; seat < N_SEATS; seat++ )
+    hands[seat] = engine.GetHand( seat );
+  for( int i = 0; i < engine.GetPlayedCount(); i++ )
+    trick[i] = engine.GetPlayed( i );
+  for( int team = 0; team < 2; team++ )
+    points[team] = engine.GetRoundPoints( team );
+  Set( hands, CardIdSuit( engine.GetTrumph() ), engine.GetLeader(),
+       trick, engine.GetPlayedCount(), points );
+}
+
+uint64_t GameState::GetCanonicalHash() const
+{
+  CanonicalPosition canonical;
+  canonical.Set( m_hands, GetTrumph(), GetLeader() );
+  return canonical.GetHash();
+}
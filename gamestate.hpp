@@ -0,0 +1,115 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _GAMESTATE_HPP_
+#define _GAMESTATE_HPP_ 1
+
+// Forward declarations
+class GameState;
+
+#include <stdint.h>
+#include "engine.hpp"
+#include "trick.hpp"
+
+// Plain state of a round for searching: moves are made with Apply() and
+// taken back with Undo(), updating the hands, the trick and the points in
+// place. No allocation and no virtual calls, and it can be copied with
+// memcpy (e.g. one copy per thread).
+// Tricks completed since the state was set are kept so they can be undone.
+class GameState
+{
+public:
+  // Trick holds the cards already played by the leader and the seats
+  // after it (an incomplete trick), points are those already captured
+  void Set( const CardSet* hands, cardsuit_t trumph, int leader,
+            const cardid_t* trick, int ntrick, const unsigned short* points = NULL );
+  void Set( const Engine& engine );
+  // The card must be a legal move of the seat to move
+  void Apply( cardid_t card );
+  // The card must be the last one applied
+  void Undo( cardid_t card );
+  CardSet LegalMoves() const
+  {
+    CardSet hand = m_hands[GetTurn()];
+    if( m_nplayed == 0 )
+      return hand;
+    CardSet follow = hand.InSuit( CardIdSuit( m_tricks[m_ntricks][0] ) );
+    return follow.IsEmpty() ? hand : follow;
+  }
+  int GetTurn() const { return ( m_leaders[m_ntricks] + m_nplayed ) % N_SEATS; }
+  int GetLeader() const { return m_leaders[m_ntricks]; }
+  cardsuit_t GetTrumph() const { return (cardsuit_t)m_trumph; }
+  CardSet GetHand( int seat ) const { return m_hands[seat]; }
+  const CardSet* GetHands() const { return m_hands; }
+  // Cards still in the hands
+  CardSet GetInPlay() const { return m_hands[0] | m_hands[1] | m_hands[2] | m_hands[3]; }
+  // Current trick, starting with the leader
+  const cardid_t* GetTrick() const { return m_tricks[m_ntricks]; }
+  int GetPlayedCount() const { return m_nplayed; }
+  cardid_t GetLead() const { return m_nplayed ? m_tricks[m_ntricks][0] : NO_CARD; }
+  int GetTricksLeft() const { return m_hands[GetTurn()].Count(); }
+  // Completed since the state was set
+  int GetTrickCount() const { return m_ntricks; }
+  bool IsRoundOver() const { return m_nplayed == 0 && m_hands[GetLeader()].IsEmpty(); }
+  int GetPoints( int team ) const { return m_points[team]; }
+  // Hash of the CanonicalPosition, between tricks
+  uint64_t GetCanonicalHash() const;
+private:
+  CardSet m_hands[N_SEATS];
+  // Tricks since the state was set, the last one being the current one
+  cardid_t m_tricks[MAX_CARDS + 1][N_SEATS];
+  unsigned char m_leaders[MAX_CARDS + 1];  // Leader of each of them
+  unsigned char m_ntricks;  // Completed
+  unsigned char m_nplayed;  // In the current trick
+  unsigned char m_trumph;
+  unsigned short m_points[2];
+};
+
+inline void GameState::Apply( cardid_t card )
+{
+  int turn = GetTurn();
+  m_hands[turn].Remove( card );
+  cardid_t* trick = m_tricks[m_ntricks];
+  trick[m_nplayed++] = card;
+  if( m_nplayed < N_SEATS )
+    return;
+  int leader = m_leaders[m_ntricks];
+  int winner = ( leader + TrickWinner( trick, CardIdSuit( trick[0] ), (cardsuit_t)m_trumph ) ) % N_SEATS;
+  m_points[Engine::TeamOf( winner )] += CardIdValue( trick[0] ) + CardIdValue( trick[1] ) +
+    CardIdValue( trick[2] ) + CardIdValue( trick[3] );
+  m_leaders[++m_ntricks] = winner;
+  m_nplayed = 0;
+}
+
+inline void GameState::Undo( cardid_t card )
+{
+  if( m_nplayed == 0 ) {
+    // Take back a complete trick
+    int winner = m_leaders[m_ntricks--];
+    const cardid_t* trick = m_tricks[m_ntricks];
+    m_points[Engine::TeamOf( winner )] -= CardIdValue( trick[0] ) + CardIdValue( trick[1] ) +
+      CardIdValue( trick[2] ) + CardIdValue( trick[3] );
+    m_nplayed = N_SEATS;
+  }
+  m_nplayed--;
+  int turn = GetTurn();
+  m_hands[turn].Add( card );
+}
+
+#endif  // _GAMESTATE_HPP_
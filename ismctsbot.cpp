@@ -0,0 +1,176 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <chrono>
+#include <cmath>
+#include "ismctsbot.hpp"
+#include "gamestate.hpp"
+
+#define ISMCTS_EXPLORATION 0.7  // UCB constant, rewards being from 0 to 1
+#define ISMCTS_CLOCK_EVERY 64  // Iterations between looks at the clock
+
+// Grows one tree per item
+class IsmctsJob: public PoolJob
+{
+public:
+  IsmctsJob( IsmctsBot& bot, CardSet hand, const cardid_t* played, int nplayed );
+  void Run( long item, int worker );
+  // Most visited move over all the trees
+  cardid_t Best() const;
+private:
+  void Iterate( std::vector<IsmctsNode>& tree, Rng& rng );
+  IsmctsBot& m_bot;
+  CardSet m_hand;
+  const cardid_t* m_played;
+  int m_nplayed;
+  DealSampler m_sampler;  // Of the unseen cards
+  bool m_worlds;  // False if no deal agrees with the play
+  int m_leader;
+  uint64_t m_seed;
+  std::chrono::steady_clock::time_point m_deadline;
+};
+
+IsmctsJob::IsmctsJob( IsmctsBot& bot, CardSet hand, const cardid_t* played, int nplayed ):
+  m_bot( bot ), m_hand( hand ), m_played( played ), m_nplayed( nplayed ),
+  m_leader( ( bot.m_seat + N_SEATS - nplayed ) % N_SEATS ), m_seed( bot.m_rng.Next() ),
+  m_deadline( std::chrono::steady_clock::now() + std::chrono::milliseconds( bot.m_budget ) )
+{
+  m_worlds = bot.SetupSampler( m_sampler, hand, played, nplayed );
+}
+
+void IsmctsJob::Run( long item, int worker )
+{
+  std::vector<IsmctsNode>& tree = m_bot.m_trees[item];
+  long trees = m_bot.m_trees.size();
+  long total = m_bot.m_iterations;
+  if( m_bot.m_maxnodes && m_bot.m_maxnodes < (unsigned long)total )
+    total = m_bot.m_maxnodes;
+  long iterations = total * ( item + 1 ) / trees - total * item / trees;
+  tree.clear();
+  tree.reserve( iterations + 1 );  // At most one node per iteration
+  IsmctsNode root = { NO_CARD, (unsigned char)( ( m_bot.m_seat + N_SEATS - 1 ) % N_SEATS ),
+                      -1, -1, 0, 0, 0.0 };
+  tree.push_back( root );
+  Rng rng( m_seed ^ ( item * 0x9e3779b97f4a7c15ULL ) );
+  for( long i = 0; i < iterations; i++ ) {
+    if( m_bot.m_budget && i && i % ISMCTS_CLOCK_EVERY == 0 &&
+        std::chrono::steady_clock::now() > m_deadline )
+      break;
+    Iterate( tree, rng );
+  }
+}
+
+void IsmctsJob::Iterate( std::vector<IsmctsNode>& tree, Rng& rng )
+{
+  CardSet hands[N_SEATS];
+  if( !m_worlds )
+    return;
+  m_sampler.Sample( rng, hands );
+  GameState state;
+  state.Set( hands, CardIdSuit( m_bot.trumph ), m_leader, m_played, m_nplayed );
+  int path[N_CARDS + 1];
+  int depth = 0;
+  int node = 0;
+  path[depth++] = node;
+  // Down the tree while every legal move has been tried, then add a node
+  while( !state.IsRoundOver() ) {
+    CardSet untried = state.LegalMoves();
+    int best = -1;
+    double bestscore = 0;
+    for( int c = tree[node].child; c >= 0; c = tree[c].sibling ) {
+      IsmctsNode& child = tree[c];
+      if( !untried.Contains( child.move ) )
+        continue;
+      untried.Remove( child.move );
+      child.avail++;
+      double score = child.reward / child.visits +
+        ISMCTS_EXPLORATION * sqrt( log( (double)child.avail ) / child.visits );
+      if( best < 0 || score > bestscore ) {
+        best = c;
+        bestscore = score;
+      }
+    }
+    if( !untried.IsEmpty() ) {
+      for( int skip = rng.Below( untried.Count() ); skip > 0; skip-- )
+        untried.PopFirst();
+      IsmctsNode child = { untried.First(), (unsigned char)state.GetTurn(),
+                           -1, tree[node].child, 0, 1, 0.0 };
+      tree[node].child = tree.size();
+      tree.push_back( child );
+      node = tree[node].child;
+      state.Apply( tree[node].move );
+      path[depth++] = node;
+      break;
+    }
+    node = best;
+    state.Apply( tree[node].move );
+    path[depth++] = node;
+  }
+  // Random play to the end of the round
+  while( !state.IsRoundOver() ) {
+    CardSet legal = state.LegalMoves();
+    for( int skip = rng.Below( legal.Count() ); skip > 0; skip-- )
+      legal.PopFirst();
+    state.Apply( legal.First() );
+  }
+  int total = state.GetPoints( 0 ) + state.GetPoints( 1 );
+  double share[2];
+  for( int team = 0; team < 2; team++ )
+    share[team] = total ? (double)state.GetPoints( team ) / total : 0.5;
+  for( int i = 0; i < depth; i++ ) {
+    IsmctsNode& n = tree[path[i]];
+    n.visits++;
+    n.reward += share[Engine::TeamOf( n.seat )];
+  }
+}
+
+cardid_t IsmctsJob::Best() const
+{
+  unsigned long visits[N_CARDS] = { 0 };
+  for( size_t t = 0; t < m_bot.m_trees.size(); t++ ) {
+    const std::vector<IsmctsNode>& tree = m_bot.m_trees[t];
+    for( int c = tree[0].child; c >= 0; c = tree[c].sibling )
+      visits[tree[c].move] += tree[c].visits;
+  }
+  CardSet legal = Engine::LegalMoves( m_hand, m_nplayed ? m_played[0] : NO_CARD );
+  cardid_t best = legal.First();
+  while( !legal.IsEmpty() ) {
+    cardid_t card = legal.PopFirst();
+    if( visits[card] > visits[best] )
+      best = card;
+  }
+  return best;
+}
+
+// ISMCTS bot implementation
+IsmctsBot::IsmctsBot( int threads, int budget, int iterations ):
+  m_pool( threads ), m_trees( m_pool.GetThreads() ), m_rng( Rng::RandomSeed() ),
+  m_budget( budget ), m_iterations( iterations ), m_maxnodes( 0 )
+{
+}
+
+cardid_t IsmctsBot::PlayCard( CardSet hand, const cardid_t* played, int nplayed )
+{
+  CardSet legal = Engine::LegalMoves( hand, nplayed ? played[0] : NO_CARD );
+  if( legal.Count() == 1 )
+    return legal.First();
+  IsmctsJob job( *this, hand, played, nplayed );
+  m_pool.Run( job, m_trees.size() );
+  return job.Best();
+}
@@ -0,0 +1,77 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _ISMCTSBOT_HPP_
+#define _ISMCTSBOT_HPP_ 1
+
+// Forward declarations
+struct IsmctsNode;
+class IsmctsBot;
+
+#include <vector>
+#include "smartbot.hpp"
+#include "rng.hpp"
+#include "workpool.hpp"
+
+#define ISMCTS_ITERATIONS 20000  // Most iterations for a move, over all threads
+#define ISMCTS_BUDGET 500  // Time per move for players at the table, in ms
+
+// Node of a search tree over information sets: the moves made since the
+// bot's turn, whatever the hidden cards. Nodes live in one array per tree
+// and link to each other by index.
+struct IsmctsNode
+{
+  cardid_t move;  // That led here
+  unsigned char seat;  // That made the move
+  int child;  // First one, -1 if none
+  int sibling;  // Next child of the parent, -1 if none
+  unsigned int visits;
+  unsigned int avail;  // Times the move was legal when the parent was visited
+  double reward;  // Sum of the share of the points won by the seat's team
+};
+
+// Information set Monte Carlo tree search bot. Every iteration deals
+// the unseen cards at random (with a DealSampler), walks down the
+// tree among the moves legal in that deal, and plays the rest of the
+// round at random.
+// Root parallel: every thread grows its own tree, and the trees are
+// merged by adding up the visits of the bot's moves.
+// Anytime: stops at the time budget or at the iteration cap, whatever
+// comes first. With no budget, the same seed gives the same moves.
+// Its search nodes are iterations.
+class IsmctsBot: public SmartBot
+{
+public:
+  // 0 threads means one per hardware thread, a budget of 0 ms means no
+  // time limit (just the number of iterations)
+  IsmctsBot( int threads = 1, int budget = 0, int iterations = ISMCTS_ITERATIONS );
+  void SetBudget( int budget, unsigned long nodes = 0 ) { m_budget = budget; m_maxnodes = nodes; }
+  void Seed( uint64_t seed ) { m_rng.Seed( seed ); }
+  cardid_t PlayCard( CardSet hand, const cardid_t* played, int nplayed );
+protected:
+  friend class IsmctsJob;
+  WorkPool m_pool;
+  std::vector< std::vector<IsmctsNode> > m_trees;  // One per thread
+  Rng m_rng;
+  int m_budget;
+  int m_iterations;
+  unsigned long m_maxnodes;  // Caps the iterations too, 0 if not
+};
+
+#endif  // _ISMCTSBOT_HPP_
@@ -0,0 +1,163 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <cstdio>
+#include <cstring>
+#include "leadbook.hpp"
+#include "canonical.hpp"
+
+// Slot layout: the key (a 40 bit card mask, then 3 bits for the trumph
+// shown) in the low bits, then the lead
+#define SHOWN_SHIFT N_CARDS
+#define SLOT_LEAD_SHIFT ( N_CARDS + 3 )
+#define SLOT_KEY_MASK ( ( (uint64_t)1 << SLOT_LEAD_SHIFT ) - 1 )
+#define ZERO_MASK ( ( 1 << ( QUEEN - TWO ) ) - 1 )  // Two to Six
+
+struct LeadBookHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t bits;  // 2^bits slots
+  uint64_t count;
+};
+
+static const char leadbook_magic[8] = { 'S', 'U', 'E', 'C', 'A', 'B', 'O', 'K' };
+
+LeadBook lead_book;
+
+// The zero point cards of each suit moved down to its lowest ranks
+static CardSet LowCardsDown( CardSet hand )
+{
+  cardmask_t mask = hand.GetMask();
+  for( int suit = 0; suit < N_SUITS; suit++ ) {
+    int shift = suit * N_RANKS;
+    unsigned int low = ( mask >> shift ) & ZERO_MASK;
+    mask &= ~( (cardmask_t)ZERO_MASK << shift );
+    mask |= (cardmask_t)( ( 1 << __builtin_popcount( low ) ) - 1 ) << shift;
+  }
+  return CardSet( mask );
+}
+
+// Lead book implementation
+LeadBook::LeadBook():
+  m_slots( NULL ), m_mask( 0 ), m_count( 0 )
+{
+}
+
+bool LeadBook::Open( const char* path )
+{
+  Close();
+  if( !m_file.Open( path ) )
+    return false;
+  // Refuse files of other versions or cut short
+  const LeadBookHeader* header = (const LeadBookHeader*)m_file.GetData();
+  if( m_file.GetSize() < sizeof( LeadBookHeader ) ||
+      memcmp( header->magic, leadbook_magic, sizeof( leadbook_magic ) ) ||
+      header->version != LEADBOOK_VERSION || header->bits > 40 ||
+      ( m_file.GetSize() - sizeof( LeadBookHeader ) ) / sizeof( uint64_t ) < (uint64_t)1 << header->bits ) {
+    m_file.Close();
+    return false;
+  }
+  m_slots = (const uint64_t*)( header + 1 );
+  m_mask = ( (uint64_t)1 << header->bits ) - 1;
+  m_count = header->count;
+  return true;
+}
+
+void LeadBook::Close()
+{
+  m_file.Close();
+  m_slots = NULL;
+  m_mask = 0;
+  m_count = 0;
+}
+
+uint64_t LeadBook::Key( CardSet hand, cardid_t shown )
+{
+  // 0 for the zero point ranks, then 1 (Queen) to 5 (Ace)
+  int rank = CardIdValue( shown ) ? CardIdRank( shown ) - ( QUEEN - TWO ) + 1 : 0;
+  return CanonicalHand( LowCardsDown( hand ), CardIdSuit( shown ) ).GetMask() |
+    (uint64_t)rank << SHOWN_SHIFT;
+}
+
+cardid_t LeadBook::ToBook( CardSet hand, cardsuit_t trumph, cardid_t card )
+{
+  unsigned char suits[N_SUITS];
+  CanonicalHand( LowCardsDown( hand ), trumph, suits );
+  int suit = CardIdSuit( card );
+  int rank = CardIdRank( card );
+  if( !CardIdValue( card ) ) {
+    unsigned int held = ( hand.GetMask() >> ( suit * N_RANKS ) ) & ZERO_MASK;
+    rank = __builtin_popcount( held & ( ( 1 << rank ) - 1 ) );
+  }
+  return suits[suit] * N_RANKS + rank;
+}
+
+cardid_t LeadBook::Lookup( CardSet hand, cardid_t shown ) const
+{
+  if( !m_slots || hand.IsEmpty() )
+    return NO_CARD;
+  uint64_t key = Key( hand, shown );
+  cardsuit_t trumph = CardIdSuit( shown );
+  for( uint64_t i = MixBits( key ) & m_mask; m_slots[i]; i = ( i + 1 ) & m_mask ) {
+    if( ( m_slots[i] & SLOT_KEY_MASK ) != key )
+      continue;
+    // Back from the book to a card of the hand
+    cardid_t lead = (cardid_t)( m_slots[i] >> SLOT_LEAD_SHIFT );
+    for( CardSet cards = hand; !cards.IsEmpty(); ) {
+      cardid_t card = cards.PopFirst();
+      if( ToBook( hand, trumph, card ) == lead )
+        return card;
+    }
+    return NO_CARD;
+  }
+  return NO_CARD;
+}
+
+bool LeadBook::Write( const char* path, const std::vector<LeadBookEntry>& entries )
+{
+  // At most half full
+  int bits = 1;
+  while( ( (size_t)1 << bits ) < 2 * entries.size() )
+    bits++;
+  uint64_t mask = ( (uint64_t)1 << bits ) - 1;
+  std::vector<uint64_t> slots( mask + 1, 0 );
+  size_t count = 0;
+  for( size_t n = 0; n < entries.size(); n++ ) {
+    uint64_t key = entries[n].key;
+    uint64_t i = MixBits( key ) & mask;
+    while( slots[i] && ( slots[i] & SLOT_KEY_MASK ) != key )
+      i = ( i + 1 ) & mask;
+    if( slots[i] )
+      continue;
+    slots[i] = key | (uint64_t)entries[n].lead << SLOT_LEAD_SHIFT;
+    count++;
+  }
+  FILE* file = fopen( path, "wb" );
+  if( !file )
+    return false;
+  LeadBookHeader header;
+  memcpy( header.magic, leadbook_magic, sizeof( leadbook_magic ) );
+  header.version = LEADBOOK_VERSION;
+  header.bits = bits;
+  header.count = count;
+  bool ok = fwrite( &header, sizeof( header ), 1, file ) == 1 &&
+    fwrite( &slots[0], sizeof( uint64_t ), slots.size(), file ) == slots.size();
+  return fclose( file ) == 0 && ok;
+}
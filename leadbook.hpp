@@ -0,0 +1,79 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _LEADBOOK_HPP_
+#define _LEADBOOK_HPP_ 1
+
+// Forward declarations
+struct LeadBookEntry;
+class LeadBook;
+
+#include <stdint.h>
+#include <vector>
+#include "cardset.hpp"
+#include "mappedfile.hpp"
+
+#define LEADBOOK_VERSION 2
+#define LEADBOOK_FILE "sueca.book"
+
+// Opening lead found offline for a hand, both as book keys and cards
+struct LeadBookEntry
+{
+  uint64_t key;
+  cardid_t lead;
+};
+
+// Read only book of opening leads (the first card of a round), made
+// offline by sueca-bookgen and mapped in memory.
+// Hands are taken as equal when they only differ by the non trumph
+// suits being swapped, or by which zero point cards of a suit they hold
+// (how many matters): the book has the suits relabeled as by
+// CanonicalHand() and those cards at the lowest ranks.
+// The trumph card the leader's right hand opponent turned up is part of
+// the key, by its rank, zero point ones all being the same.
+// File layout: a header, then an open addressing hash table with room
+// for twice the hands, so a lookup reads one or two slots.
+// Lookups are thread safe once the book is open.
+class LeadBook
+{
+public:
+  LeadBook();
+  bool Open( const char* path );
+  void Close();
+  bool IsOpen() const { return m_file.IsOpen(); }
+  size_t GetCount() const { return m_count; }
+  // Lead for a whole hand, given the trumph card shown, NO_CARD if the
+  // hand is not in the book
+  cardid_t Lookup( CardSet hand, cardid_t shown ) const;
+  // Key of a hand, and the book card a card of the hand becomes
+  static uint64_t Key( CardSet hand, cardid_t shown );
+  static cardid_t ToBook( CardSet hand, cardsuit_t trumph, cardid_t card );
+  // Later entries of a hand already there are dropped
+  static bool Write( const char* path, const std::vector<LeadBookEntry>& entries );
+private:
+  MappedFile m_file;
+  const uint64_t* m_slots;
+  uint64_t m_mask;
+  size_t m_count;
+};
+
+// The book bots look at, open it before they start
+extern LeadBook lead_book;
+
+#endif  // _LEADBOOK_HPP_
@@ -20,6 +20,9 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include "main.hpp"
 #include "player.hpp"
 #include "smartplayer.hpp"
+#include "endgame.hpp"
+#include "leadbook.hpp"
+#include "decisioncache.hpp"
 #include <wx/config.h>
 #include <wx/utils.h>
 
@@ -32,9 +35,6 @@ END_EVENT_TABLE();
 
 bool Sueca::OnInit()
 {
-  // Random seed initialization
-  srand( time( NULL ) );
-
   // Get stored preferences
   wxConfig* config = new wxConfig( SUECA_NAME );
   // Default preferences go here
@@ -44,8 +44,25 @@ bool Sueca::OnInit()
   config->Read( "Connect IP address", &connect_ip_address, wxEmptyString );
   config->Read( "Player name", &playername, wxGetUserId() );
   config->Read( "Update delay", (int*)&update_delay, 3 );
+  config->Read( "Bot level", (int*)&bot_level, BOT_DEFAULT_LEVEL );
+  if( bot_level >= N_BOT_LEVELS )
+    bot_level = BOT_DEFAULT_LEVEL;
+  config->Read( "Use endgame table", &use_endgame_table, false );
   delete config;
 
+  // Solved endgames and opening leads, for the bots (optional, made by
+  // sueca-egtgen and sueca-bookgen). The endgame table can be large, it
+  // is only mapped when asked for.
+  if( use_endgame_table )
+    endgame_table.Open( ENDGAME_FILE );
+  lead_book.Open( LEADBOOK_FILE );
+  // Decisions of the bots, kept between runs
+  decision_cache.Resize( DECISION_CACHE_BITS );
+  decision_cache.Load( DECISION_CACHE_FILE );
+
+  // One thread per seat, a table never has more bots thinking at once
+  m_botqueue = new TaskQueue( N_SEATS );
+
   servdlg = NULL;
   rmtdlg = NULL;
   servhandler = new ServerHandler();
@@ -60,6 +77,8 @@ bool Sueca::OnInit()
 int Sueca::OnExit()
 {
   PrepareExit();
+  delete m_botqueue;
+  CardArt::Free();
   return wxApp::OnExit();
 }
 
@@ -74,13 +93,17 @@ void Sueca::PrepareExit()
   config->Write( "Connect IP address", connect_ip_address );
   config->Write( "Player name", playername );
   config->Write( "Update delay", (int)update_delay );
+  config->Write( "Bot level", (int)bot_level );
+  config->Write( "Use endgame table", use_endgame_table );
   delete config;
+  decision_cache.Save( DECISION_CACHE_FILE );
 }
 
 void Sueca::NewGame( Game* the_game, LocalPlayer* lp )
 {
   m_game = the_game;
   m_frame->canvas->SetLocalPlayer( lp );
+  m_frame->canvas->SetGame( m_game );
   m_frame->viewMenu->Enable( ID_VIEW_TRUMPH, true );
   m_frame->viewMenu->Enable( ID_VIEW_SCORES, true );
   m_frame->gameMenu->Enable( wxID_CLOSE, true );
@@ -95,6 +118,7 @@ void Sueca::EndGame()
     m_frame->viewMenu->Enable( ID_VIEW_SCORES, false );
     m_frame->gameMenu->Enable( wxID_CLOSE, false );
     m_frame->canvas->SetLocalPlayer( NULL );
+    m_frame->canvas->SetGame( NULL );
     m_game = NULL;
     m_frame->SetStatusText("", 1);
     m_frame->Refresh();
@@ -119,7 +143,9 @@ void Sueca::SetLocalPlayerName( const wxString& newname )
 Player* Sueca::GetBotPlayer( GamePos* gamepos )
 {
   //return new DumbPlayer( gamepos );
-  return new SmartPlayer( gamepos );
+  //return new SmartPlayer( gamepos );
+  //return new IsmctsPlayer( gamepos, Bot::level_budgets[bot_level] );
+  return new PimcPlayer( gamepos, Bot::level_budgets[bot_level] );
 }
 
 void Sueca::OnFinishRemoteHandler( FinishRemoteHandlerEvt& event )
@@ -43,6 +43,7 @@ class Sueca;
 #include "serverdialog.hpp"
 #include "remotedialog.hpp"
 #include "game.hpp"
+#include "taskqueue.hpp"
 
 class Sueca: public wxApp
 {
@@ -69,16 +70,27 @@ public:
   void SetLocalPlayerName( const wxString& newname );
   unsigned int GetUpdateDelay() const { return update_delay; }
   void SetUpdateDelay( int new_delay ) { update_delay = new_delay; }
+  // Strength of the computer players, 0 to N_BOT_LEVELS - 1
+  unsigned int GetBotLevel() const { return bot_level; }
+  void SetBotLevel( int new_level ) { bot_level = new_level; }
+  // Whether the bots look up the endgame table, from the next start
+  bool GetUseEndgameTable() const { return use_endgame_table; }
+  void SetUseEndgameTable( bool use ) { use_endgame_table = use; }
   Game* GetGame() const { return m_game; }
   Player* GetBotPlayer( GamePos* gamepos );
+  // Where the bots think, off the GUI thread
+  TaskQueue& GetBotQueue() { return *m_botqueue; }
   void OnFinishRemoteHandler( FinishRemoteHandlerEvt& event );
 private:
   // Preferences not directly accessible
   wxString playername;
   unsigned int update_delay;
+  unsigned int bot_level;
+  bool use_endgame_table;
 
   Game* m_game;
   MyFrame* m_frame;
+  TaskQueue* m_botqueue;
   DECLARE_EVENT_TABLE();
 };
 
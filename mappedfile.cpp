@@ -0,0 +1,98 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "mappedfile.hpp"
+
+// Mapped file implementation
+MappedFile::MappedFile():
+  m_data( NULL ), m_size( 0 )
+{
+#ifdef _WIN32
+  m_file = m_mapping = NULL;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+bool MappedFile::Open( const char* path )
+{
+  Close();
+#ifdef _WIN32
+  HANDLE file = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL, NULL );
+  if( file == INVALID_HANDLE_VALUE )
+    return false;
+  LARGE_INTEGER size;
+  HANDLE mapping = NULL;
+  if( GetFileSizeEx( file, &size ) && size.QuadPart > 0 )
+    mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+  void* data = mapping ? MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) : NULL;
+  if( !data ) {
+    if( mapping )
+      CloseHandle( mapping );
+    CloseHandle( file );
+    return false;
+  }
+  m_file = file;
+  m_mapping = mapping;
+  m_data = data;
+  m_size = (size_t)size.QuadPart;
+#else
+  int fd = open( path, O_RDONLY );
+  if( fd < 0 )
+    return false;
+  struct stat st;
+  void* data = MAP_FAILED;
+  if( fstat( fd, &st ) == 0 && st.st_size > 0 )
+    data = mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+  close( fd );  // The mapping stays
+  if( data == MAP_FAILED )
+    return false;
+  m_data = data;
+  m_size = st.st_size;
+#endif
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if( !m_data )
+    return;
+#ifdef _WIN32
+  UnmapViewOfFile( m_data );
+  CloseHandle( (HANDLE)m_mapping );
+  CloseHandle( (HANDLE)m_file );
+  m_file = m_mapping = NULL;
+#else
+  munmap( m_data, m_size );
+#endif
+  m_data = NULL;
+  m_size = 0;
+}
@@ -0,0 +1,49 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _MAPPEDFILE_HPP_
+#define _MAPPEDFILE_HPP_ 1
+
+// Forward declarations
+class MappedFile;
+
+#include <cstddef>  // For size_t and NULL
+
+// Whole file mapped in memory read only (mmap, or a file mapping on
+// Windows), so processes using the same file share its pages
+class MappedFile
+{
+public:
+  MappedFile();
+  ~MappedFile();
+  bool Open( const char* path );
+  void Close();
+  bool IsOpen() const { return m_data != NULL; }
+  const void* GetData() const { return m_data; }
+  size_t GetSize() const { return m_size; }
+private:
+  void* m_data;
+  size_t m_size;
+#ifdef _WIN32
+  void* m_file;  // Windows handles
+  void* m_mapping;
+#endif
+};
+
+#endif  // _MAPPEDFILE_HPP_
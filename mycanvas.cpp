@@ -75,8 +75,8 @@ void NameLabel::Draw( wxDC& dc )
 TrumphLabel::TrumphLabel( Player* player, Card* card, wxDC& dc ):
   m_card( card ), m_visible( true )
 {
-  m_text = card->GetType().GetShortName();
-  m_bmp = card->GetSuit().GetBitmap();
+  m_text = wxString( CardIdLetter( card->GetId() ) );
+  m_bmp = card->GetDeck()->GetSuitBitmap( card->GetSuit() );
   wxCoord w; wxCoord h;
   dc.GetTextExtent( m_text, &w, &h );
   m_bmppos = wxPoint( 0, 0 );
@@ -124,7 +124,7 @@ END_EVENT_TABLE()
 MyCanvas::MyCanvas( wxFrame* parent, wxWindowID id ):
   wxPanel( parent, id, wxDefaultPosition, wxDefaultSize, wxSUNKEN_BORDER ),
   flashing( NULL ), statusbar( parent->GetStatusBar() ), m_localplayer( NULL ),
-  m_trumph( NULL ), m_buffer( MC_X_SIZE, MC_Y_SIZE ), fltimer( this ),
+  m_game( NULL ), m_trumph( NULL ), m_buffer( MC_X_SIZE, MC_Y_SIZE ), fltimer( this ),
   lastclicked( NULL )
 {
 
@@ -176,12 +176,12 @@ void MyCanvas::OnMouseEvent( wxMouseEvent& event )
   if( event.LeftDClick() && m_trumph &&
       m_trumph->GetRect().Contains( event.GetPosition() ) ) {
     wxGetApp().GetFrame()->viewMenu->Check( ID_VIEW_TRUMPH, true );
-    wxGetApp().GetGame()->trumphdlg->Show( true );
+    m_game->trumphdlg->Show( true );
   }
   else if( event.LeftDown() && m_localplayer ) {
     Card *playcard = FindCard( event.GetPosition(), &pos );
     if( playcard && playcard->IsPlayable() )
-      switch( wxGetApp().GetGame()->PlayMove( m_localplayer, playcard ) ) {
+      switch( m_game->PlayMove( m_localplayer, playcard ) ) {
       case MOVE_TURN:
 	NotTurnWarning();
         break;
@@ -337,12 +337,12 @@ void MyCanvas::SetTrumphLabel( Player* player, Card* card )
 void MyCanvas::OnCardMoveEvent( CardMoveEvent& event )
 {
   // Ignore events concerning no longer existing games
-  if( wxGetApp().GetGame() != event.owner )
+  if( m_game != event.owner )
     return;
   double diffx = event.destpos.x - event.pos.x;
   double diffy = event.destpos.y - event.pos.y;
   if( diffx*diffx + diffy*diffy <= STOP_PREC ) {
-    wxGetApp().GetGame()->CardMoved( event.card );
+    event.owner->CardMoved( event.card );
     return;
   }
   wxRegion update_reg;
@@ -370,14 +370,14 @@ void MyCanvas::OnCardMoveEvent( CardMoveEvent& event )
   AddPendingEvent( event );
 }
 
-void MyCanvas::MoveCardTo( Card* card, wxPoint destpos, bool raise )
+void MyCanvas::MoveCardTo( Card* card, wxPoint destpos, Game* owner, bool raise )
 {
   if( raise ) {
     if( !m_displayList.DeleteObject( card ) )
       return;
     m_displayList.Insert( card );
   }
-  CardMoveEvent event( card, destpos, wxGetApp().GetGame() );
+  CardMoveEvent event( card, destpos, owner );
   AddPendingEvent( event );
 }
 
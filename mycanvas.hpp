@@ -135,10 +135,12 @@ public:
   void Remove( Card* crd, bool update = true );
   void SetLocalPlayer( LocalPlayer *player ) { m_localplayer = player; }
   LocalPlayer* GetLocalPlayer() { return m_localplayer; }
+  // Game being displayed, other games' card moves are ignored
+  void SetGame( Game* game ) { m_game = game; }
   void SetNameLabel( int playerno, Player* player );
   void SetTrumphLabel( Player* player, Card* card );
   void OnCardMoveEvent( CardMoveEvent& event );
-  void MoveCardTo( Card* card, wxPoint destpos, bool raise = true );
+  void MoveCardTo( Card* card, wxPoint destpos, Game* owner, bool raise = true );
   void FlashCard( Card* card );
   void NotTurnWarning();
   void InvalidLocalMove( Card* card = NULL );
@@ -146,6 +148,7 @@ private:
   wxStatusBar* statusbar;
   CardList m_displayList;
   LocalPlayer* m_localplayer;
+  Game* m_game;
   NameLabel *m_names[4];
   TrumphLabel *m_trumph;
   wxBitmap m_buffer;
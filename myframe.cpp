@@ -131,6 +131,7 @@ MyFrame::~MyFrame()
 void MyFrame::OnNew( wxCommandEvent& event )
 {
   if( ProceedWithNewGame() ) {
+    wxGetApp().EndGame();
     LocalPlayer* p1 = new LocalPlayer( wxGetApp().GetLocalPlayerName(), new GamePosP1() );
     //Player* p1 = wxGetApp().GetBotPlayer( new GamePosP1() );
     Player* p2 = wxGetApp().GetBotPlayer( new GamePosP2() );
@@ -50,12 +50,12 @@ void NetServerPlayer::NewGame( Game* game )
 
 void NetServerPlayer::NewRound( Card* trumph, Player* owner )
 {
-  CardList::Node* node = GetHand().GetFirst();
-  wxString hand_str = node->GetData()->ShortStr();
-  node = node->GetNext();
+  Deck* deck = trumph->GetDeck();
+  CardSet hand = GetHand();
+  wxString hand_str = deck->GetCard( hand.PopFirst() )->ShortStr();
   do
-    hand_str += ":" + node->GetData()->ShortStr();
-  while( ( node = node->GetNext() ) );
+    hand_str += ":" + deck->GetCard( hand.PopFirst() )->ShortStr();
+  while( ! hand.IsEmpty() );
   SocketPrintln( m_socket,
 		 wxString::Format( "round:%s:%s:%s",
 				   hand_str.c_str(),
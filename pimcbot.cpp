@@ -0,0 +1,336 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <cstring>  // For memset(), memcpy()
+#include "pimcbot.hpp"
+#include "leadbook.hpp"
+#include "decisioncache.hpp"
+#include "zobrist.hpp"
+
+#define PIMC_TABLE_BITS 19
+#define PONDER_UNKNOWN -1
+
+// World scores of one thread, summed up at the end
+struct alignas( 64 ) PimcScores
+{
+  long sum[MAX_CARDS];  // Team 0 points after each move
+  int worlds;
+};
+
+// Solves one world per item, the worlds being drawn beforehand, so
+// that every pass (one per horizon) sees the same ones
+class PimcJob: public PoolJob
+{
+public:
+  PimcJob( PimcBot& bot, CardSet hand, const cardid_t* played, int nplayed );
+  // Starts a pass, forgetting the scores of the last one
+  void SetHorizon( int horizon );
+  void Run( long item, int worker );
+  int GetMoveCount() const { return m_nmoves; }
+  cardid_t GetMove( int i ) const { return m_moves[i]; }
+  long GetWorldCount() const { return m_worlds.size() / N_SEATS; }
+  // Worlds solved in this pass
+  long GetSolved() const;
+  // Best move for the bot's team, NO_CARD if no world was solved, and
+  // the average points the team gets with it of those in play
+  cardid_t Best( int* value = NULL ) const;
+private:
+  PimcBot& m_bot;
+  CardSet m_hand;
+  const cardid_t* m_played;
+  int m_nplayed;
+  std::vector<CardSet> m_worlds;  // N_SEATS hands each, none if no deal fits
+  cardid_t m_moves[MAX_CARDS];
+  int m_nmoves;
+  uint64_t m_seed;
+  int m_horizon;
+  std::vector<PimcScores> m_scores;
+};
+
+PimcJob::PimcJob( PimcBot& bot, CardSet hand, const cardid_t* played, int nplayed ):
+  m_bot( bot ), m_hand( hand ), m_played( played ), m_nplayed( nplayed ),
+  m_nmoves( 0 ), m_seed( bot.m_rng.Next() ), m_horizon( 0 ),
+  m_scores( bot.m_pool.GetThreads() )
+{
+  DealSampler sampler;
+  if( bot.SetupSampler( sampler, hand, played, nplayed ) ) {
+    Rng rng( m_seed );
+    int leader = ( bot.m_seat + N_SEATS - nplayed ) % N_SEATS;
+    m_worlds.resize( bot.m_worlds * N_SEATS );
+    bot.m_model.Resample( sampler, rng, bot.m_seat, leader, played, nplayed,
+                          &m_worlds[0], bot.m_worlds, PIMC_CANDIDATES * bot.m_worlds );
+  }
+  for( CardSet legal = Engine::LegalMoves( hand, nplayed ? played[0] : NO_CARD );
+       !legal.IsEmpty(); )
+    m_moves[m_nmoves++] = legal.PopFirst();
+}
+
+void PimcJob::SetHorizon( int horizon )
+{
+  m_horizon = horizon;
+  memset( &m_scores[0], 0, m_scores.size() * sizeof( PimcScores ) );
+}
+
+void PimcJob::Run( long item, int worker )
+{
+  if( m_worlds.empty() || m_bot.m_limit.IsOver() )
+    return;
+  const CardSet* hands = &m_worlds[item * N_SEATS];
+  Solver& solver = *m_bot.m_solvers[worker];
+  int leader = ( m_bot.m_seat + N_SEATS - m_nplayed ) % N_SEATS;
+  solver.SetPosition( hands, CardIdSuit( m_bot.trumph ), leader, m_played, m_nplayed );
+  solver.SetHorizon( m_horizon );
+  long sum[MAX_CARDS];
+  for( int i = 0; i < m_nmoves; i++ )
+    sum[i] = solver.SolveMove( m_moves[i] );
+  // A world left halfway is worth nothing
+  if( solver.IsAborted() )
+    return;
+  PimcScores& scores = m_scores[worker];
+  for( int i = 0; i < m_nmoves; i++ )
+    scores.sum[i] += sum[i];
+  scores.worlds++;
+}
+
+long PimcJob::GetSolved() const
+{
+  long worlds = 0;
+  for( size_t t = 0; t < m_scores.size(); t++ )
+    worlds += m_scores[t].worlds;
+  return worlds;
+}
+
+cardid_t PimcJob::Best( int* value ) const
+{
+  long sum[MAX_CARDS] = { 0 };
+  int worlds = 0;
+  for( size_t t = 0; t < m_scores.size(); t++ ) {
+    for( int i = 0; i < m_nmoves; i++ )
+      sum[i] += m_scores[t].sum[i];
+    worlds += m_scores[t].worlds;
+  }
+  if( !worlds )
+    return NO_CARD;
+  // Team 1 wants team 0 to get as little as possible
+  bool maximize = Engine::TeamOf( m_bot.m_seat ) == 0;
+  int best = 0;
+  for( int i = 1; i < m_nmoves; i++ )
+    if( maximize ? sum[i] > sum[best] : sum[i] < sum[best] )
+      best = i;
+  if( value ) {
+    *value = sum[best] / worlds;
+    if( !maximize )
+      *value = ( ~m_bot.out ).Points() - *value;
+  }
+  return m_moves[best];
+}
+
+// PIMC bot implementation
+PimcBot::PimcBot( int threads, int budget, int worlds ):
+  m_pool( threads ), m_table( PIMC_TABLE_BITS ), m_solvers( m_pool.GetThreads() ),
+  m_rng( Rng::RandomSeed() ), m_budget( budget ), m_maxnodes( 0 ), m_worlds( worlds ),
+  m_pondern( 0 ), m_nanswers( 0 ), m_pondering( NO_CARD ), m_actual( PONDER_UNKNOWN )
+{
+  // Without a budget the limit only stops pondering
+  for( size_t i = 0; i < m_solvers.size(); i++ ) {
+    m_solvers[i] = new Solver( m_table );
+    m_solvers[i]->SetLimit( &m_limit );
+  }
+}
+
+PimcBot::~PimcBot()
+{
+  for( size_t i = 0; i < m_solvers.size(); i++ )
+    delete m_solvers[i];
+}
+
+void PimcBot::NewRound( CardSet hand, cardid_t newtrumph, int newowner )
+{
+  SmartBot::NewRound( hand, newtrumph, newowner );
+  m_model.NewRound( CardIdSuit( newtrumph ) );
+  // Old positions are still right, but would only crowd the table
+  m_table.Clear();
+  m_nanswers = 0;
+  m_actual = PONDER_UNKNOWN;
+}
+
+void PimcBot::TrickEnd( int leader, const cardid_t* played )
+{
+  SmartBot::TrickEnd( leader, played );
+  m_model.TrickEnd( leader, played );
+  m_nanswers = 0;
+}
+
+cardid_t PimcBot::PlayCard( CardSet hand, const cardid_t* played, int nplayed )
+{
+  // The first card of the round, the slowest to search, may be in the book
+  if( !nplayed && hand.Count() == MAX_CARDS ) {
+    cardid_t card = lead_book.Lookup( hand, trumph );
+    if( card != NO_CARD )
+      return card;
+  }
+  // Answered already while the seat before decided
+  cardid_t card = NO_CARD;
+  if( nplayed == m_pondern + 1 && hand == m_ponderhand &&
+      !memcmp( played, m_ponderplayed, m_pondern ) )
+    for( int i = 0; i < m_nanswers; i++ )
+      if( m_guesses[i] == played[nplayed - 1] )
+        card = m_answers[i];
+  m_nanswers = 0;
+  m_actual = PONDER_UNKNOWN;
+  if( card != NO_CARD )
+    return card;
+  // Decided already, by any bot searching the same way
+  uint64_t key = 0;
+  unsigned char suits[N_SUITS];
+  CardSet legal = Engine::LegalMoves( hand, nplayed ? played[0] : NO_CARD );
+  if( decision_cache.IsEnabled() && legal.Count() > 1 ) {
+    key = MixBits( InfosetKey( hand, played, nplayed, suits ) ^
+                   MixBits( (uint64_t)m_budget << 40 ^ (uint64_t)m_maxnodes << 8 ^ m_worlds ) );
+    cardid_t cached;
+    if( decision_cache.Lookup( key, &cached, NULL ) )
+      for( CardSet cards = legal; !cards.IsEmpty(); ) {
+        cardid_t card = cards.PopFirst();
+        if( suits[CardIdSuit( card )] * N_RANKS + CardIdRank( card ) == cached )
+          return card;
+      }
+  }
+  m_limit.Start( m_budget, m_maxnodes );
+  int value = -1;
+  bool complete;
+  card = Think( hand, played, nplayed, &value, &complete );
+  // A search cut short by the limit is not worth keeping
+  if( key && complete && value >= 0 )
+    decision_cache.Store( key, suits[CardIdSuit( card )] * N_RANKS + CardIdRank( card ), value );
+  return card;
+}
+
+cardid_t PimcBot::Think( CardSet hand, const cardid_t* played, int nplayed, int* value,
+                         bool* complete )
+{
+  PimcJob job( *this, hand, played, nplayed );
+  if( complete )
+    *complete = true;
+  if( job.GetMoveCount() == 1 )
+    return job.GetMove( 0 );
+  int tricks = hand.Count();
+  cardid_t card = NO_CARD;
+  bool solved = false;
+  if( !m_limit.IsSet() ) {
+    job.SetHorizon( tricks > PIMC_EXACT_TRICKS ? PIMC_HORIZON : 0 );
+    m_pool.Run( job, m_worlds );
+    solved = job.GetSolved() == job.GetWorldCount();
+    card = job.Best( value );
+  }
+  else {
+    // Iterative deepening: a pass cut short only counts if it is the
+    // first one, the last pass done is better
+    for( int horizon = 1; ; horizon++ ) {
+      job.SetHorizon( horizon < tricks ? horizon : 0 );
+      m_pool.Run( job, m_worlds );
+      bool done = job.GetSolved() == job.GetWorldCount();
+      if( done || card == NO_CARD )
+        card = job.Best( value );
+      solved = solved || done;
+      if( !done || horizon >= tricks )
+        break;
+    }
+  }
+  if( complete )
+    *complete = solved && card != NO_CARD;
+  return card != NO_CARD ? card : SmartBot::PlayCard( hand, played, nplayed );
+}
+
+void PimcBot::Ponder( CardSet hand, const cardid_t* played, int nplayed )
+{
+  m_nanswers = 0;
+  // Who leads after the trick is over is not known yet
+  if( nplayed >= N_SEATS - 1 )
+    return;
+  m_limit.Start( 0, 0 );
+  cardid_t guesses[PIMC_PONDER_GUESSES];
+  int n = GuessMoves( hand, played, nplayed, guesses );
+  m_ponderhand = hand;
+  memcpy( m_ponderplayed, played, nplayed );
+  m_pondern = nplayed;
+  cardid_t trick[N_SEATS];
+  memcpy( trick, played, nplayed );
+  for( int i = 0; i < n; i++ ) {
+    // The guess is published before the limit starts: a stop seeing an
+    // older one may still land on the new limit, but then the card it
+    // brings is read below
+    m_pondering = guesses[i];
+    m_limit.Start( m_budget, m_maxnodes );
+    int actual = m_actual;
+    if( actual != PONDER_UNKNOWN && actual != guesses[i] )
+      continue;
+    trick[nplayed] = guesses[i];
+    bool complete;
+    cardid_t card = Think( hand, trick, nplayed + 1, NULL, &complete );
+    m_pondering = NO_CARD;
+    // Stopped halfway if another card came. An answer cut short is not
+    // kept either, PlayCard() searches again instead.
+    actual = m_actual;
+    if( !complete || ( actual != PONDER_UNKNOWN && actual != guesses[i] ) )
+      continue;
+    m_guesses[m_nanswers] = guesses[i];
+    m_answers[m_nanswers++] = card;
+  }
+}
+
+void PimcBot::StopPondering( cardid_t card )
+{
+  // The card first, then the guess: Ponder() publishes them the other way
+  m_actual = card;
+  if( m_pondering != card )
+    m_limit.Stop();
+}
+
+// Cards the seat before most likely plays next: its best ones, a few
+// tricks deep, in the most worlds
+int PimcBot::GuessMoves( CardSet hand, const cardid_t* played, int nplayed, cardid_t* guesses )
+{
+  int seat = ( m_seat + N_SEATS - 1 ) % N_SEATS;
+  int leader = ( seat + N_SEATS - nplayed ) % N_SEATS;
+  DealSampler sampler;
+  if( !SetupSampler( sampler, hand, played, nplayed, seat ) )
+    return 0;
+  std::vector<CardSet> worlds( m_worlds * N_SEATS );
+  m_model.Resample( sampler, m_rng, m_seat, leader, played, nplayed,
+                    &worlds[0], m_worlds, PIMC_CANDIDATES * m_worlds );
+  int votes[N_CARDS] = { 0 };
+  Solver& solver = *m_solvers[0];
+  solver.SetHorizon( PIMC_PONDER_HORIZON );
+  for( int i = 0; i < m_worlds; i++ ) {
+    solver.SetPosition( &worlds[i * N_SEATS], CardIdSuit( trumph ), leader, played, nplayed );
+    votes[solver.BestMove()]++;
+  }
+  int n = 0;
+  for( ; n < PIMC_PONDER_GUESSES; n++ ) {
+    int best = 0;
+    for( int card = 1; card < N_CARDS; card++ )
+      if( votes[card] > votes[best] )
+        best = card;
+    if( !votes[best] )
+      break;
+    guesses[n] = best;
+    votes[best] = 0;
+  }
+  return n;
+}
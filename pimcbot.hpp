@@ -0,0 +1,105 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _PIMCBOT_HPP_
+#define _PIMCBOT_HPP_ 1
+
+// Forward declarations
+class PimcBot;
+
+#include <vector>
+#include <atomic>
+#include "smartbot.hpp"
+#include "rng.hpp"
+#include "playmodel.hpp"
+#include "solver.hpp"
+#include "transtable.hpp"
+#include "workpool.hpp"
+
+#define PIMC_WORLDS 40  // Most worlds solved for a move
+#define PIMC_EXACT_TRICKS 6  // Solved to the end from this many tricks left
+#define PIMC_HORIZON 3  // Tricks looked ahead before that
+#define PIMC_BUDGET 500  // Time per move for players at the table, in ms
+#define PIMC_CANDIDATES 8  // Uniform deals weighed for every world solved
+#define PIMC_PONDER_GUESSES 3  // Cards of the seat before pondered on
+#define PIMC_PONDER_HORIZON 2  // Tricks looked ahead to guess them
+
+// Perfect information Monte Carlo bot: deals the unseen cards at random
+// in ways that agree with what SmartBot tracks (cards out, voids, the
+// trumph shown by its owner), solves every such world double dummy and
+// plays the card with the best average. Worlds are picked among more
+// uniform deals by how well they explain the cards the others played.
+// Worlds are solved in parallel, with a transposition table shared by
+// all the threads.
+// With a budget it deepens: the same worlds are solved one trick
+// further every pass, and the card of the deepest pass done in time is
+// played. With none, every world is searched PIMC_HORIZON tricks ahead
+// (to the end from PIMC_EXACT_TRICKS), and the same seed gives the
+// same moves.
+// Opening leads come from the lead_book when it has the hand.
+// It ponders on the cards the seat before it most likely plays (the
+// best ones in the most worlds), each with the budget of a move; the
+// transposition table keeps what was searched.
+// Its decisions go to the decision_cache, when there is one.
+class PimcBot: public SmartBot
+{
+public:
+  // 0 threads means one per hardware thread, a budget of 0 ms means no
+  // time limit (just the number of worlds)
+  PimcBot( int threads = 1, int budget = 0, int worlds = PIMC_WORLDS );
+  ~PimcBot();
+  // Nodes are those of all the solvers
+  void SetBudget( int budget, unsigned long nodes = 0 ) { m_budget = budget; m_maxnodes = nodes; }
+  void Seed( uint64_t seed ) { m_rng.Seed( seed ); }
+  void NewRound( CardSet hand, cardid_t newtrumph, int newowner );
+  void TrickEnd( int leader, const cardid_t* played );
+  cardid_t PlayCard( CardSet hand, const cardid_t* played, int nplayed );
+  void Ponder( CardSet hand, const cardid_t* played, int nplayed );
+  void StopPondering( cardid_t card = NO_CARD );
+protected:
+  friend class PimcJob;
+  // Searches the move, the limit must have been started. Value, if
+  // known, gets what the team should get of the points in play.
+  // Complete tells whether every world was solved at least once (or there
+  // was nothing to choose): when not, the card comes from a search cut
+  // short, or from SmartBot.
+  cardid_t Think( CardSet hand, const cardid_t* played, int nplayed, int* value = NULL,
+                  bool* complete = NULL );
+  int GuessMoves( CardSet hand, const cardid_t* played, int nplayed, cardid_t* guesses );
+  WorkPool m_pool;
+  PlayModel m_model;
+  TransTable m_table;
+  std::vector<Solver*> m_solvers;  // One per thread
+  Rng m_rng;
+  SearchLimit m_limit;
+  int m_budget;
+  unsigned long m_maxnodes;
+  int m_worlds;
+  // Pondered answers to the trick m_ponderplayed and a guess of the next card
+  CardSet m_ponderhand;
+  cardid_t m_ponderplayed[N_SEATS];
+  int m_pondern;
+  cardid_t m_guesses[PIMC_PONDER_GUESSES];
+  cardid_t m_answers[PIMC_PONDER_GUESSES];
+  int m_nanswers;
+  std::atomic<int> m_pondering;  // Guess being searched, NO_CARD if none
+  std::atomic<int> m_actual;  // Card played by the seat before, -1 until known
+};
+
+#endif  // _PIMCBOT_HPP_
@@ -17,9 +17,12 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 */
 
-#include <cstdlib>  // for rand() and srand()
-#include <ctime>  // time()
 #include "player.hpp"
+#include "rng.hpp"
+#include "taskqueue.hpp"
+#include "main.hpp"
+
+DEFINE_EVENT_TYPE( BOT_MOVE_TYPE );
 
 int GamePos::xgap = (MC_X_SIZE-9*CARDBMP_INCR-CARDBMP_W)/2;
 int GamePos::ygap = (MC_Y_SIZE-9*CARDBMP_INCR-CARDBMP_H)/2;
@@ -93,27 +96,17 @@ Player::Player( GamePos* gamepos ):
 
 void Player::AddToHand( Card* newcard, MyCanvas* canvas )
 {
-  m_hand.Append( newcard );
+  // Unknown cards (hidden hands of remote players) are only displayed
+  if( newcard->GetId() != NO_CARD )
+    m_hand.Add( newcard->GetId() );
   wxPoint pos = m_gamepos->NextPosition();
   canvas->Add( newcard, pos.x, pos.y, AreCardsHidden() );
 }
 
 bool Player::IsValidMove( const Card* card, const CardList& played )
 {
-  if( ! GetHand().Find( card ) )
-    return false;  // Trying to play a card you don't have
-  if( played.GetCount() == 0 )
-    return true;  // First to play
-  CardSuit current_suit = played.GetFirst()->GetData()->GetSuit();
-  if( card->GetSuit() == current_suit )
-    return true;
-  CardList::Node* node = GetHand().GetFirst();
-  while( node ) {
-    if( node->GetData()->GetSuit() == current_suit )
-      return false;  // Trying to cheat :)
-    node = node->GetNext();
-  }
-  return true;
+  cardid_t lead = played.GetCount() ? played.GetFirst()->GetData()->GetId() : NO_CARD;
+  return Engine::IsLegal( m_hand, card->GetId(), lead );
 }
 
 void Player::SetGamePos( GamePos* newpos )
@@ -124,7 +117,7 @@ void Player::SetGamePos( GamePos* newpos )
 
 // Team class implementation
 Team::Team( Player* np1, Player* np2 ):
-  m_won( 0 ), m_points( 0 ), p1( np1 ), p2( np2 ), wonstr( "" )
+  m_won( 0 ), p1( np1 ), p2( np2 ), wonstr( "" )
 {
   p1->SetTeam( this );
   p2->SetTeam( this );
@@ -132,18 +125,12 @@ Team::Team( Player* np1, Player* np2 ):
 
 void Team::AddToCapt( CardList& cards )
 {
-  CardList::Node* node = cards.GetFirst();
-  while( node ) {
-    Card* crd = node->GetData();
-    m_points += crd->GetType().GetValue();
-    captured.Append( crd );
-    node = node->GetNext();
-  }
+  for( CardList::Node* node = cards.GetFirst(); node; node = node->GetNext() )
+    captured.Add( node->GetData()->GetId() );
 }
 
 void Team::NewRound( Card* trumph, Player* owner )
 {
-  m_points = 0;
   captured.Clear();
   p1->NewRound( trumph, owner );
   p2->NewRound( trumph, owner );
@@ -176,32 +163,16 @@ LocalPlayer::LocalPlayer( const wxString& name, GamePos* gamepos ):
 
 void LocalPlayer::AddToHand( Card* newcard, MyCanvas* canvas )
 {
-  // Sort cards as we add them to the player's hand
-  CardList::Node *node = GetHand().GetFirst();
-  while( node && newcard->GetSuit() > node->GetData()->GetSuit() )
-    node = node->GetNext();
-  if ( !node )
-    GetHand().Append( newcard );
-  else {
-    while( node &&
-           newcard->GetSuit() == node->GetData()->GetSuit() &&
-           newcard->GetType() > node->GetData()->GetType() )
-      node = node->GetNext();
-    if ( !node )
-      GetHand().Append( newcard );
-    else
-      GetHand().Insert( node, newcard );
-  }
-  // Delay canvas placing until we reach the last card
-  // because of the sorting
-  if ( GetHand().GetCount() == 10 ) {
-    node = GetHand().GetFirst();
-    while( node ) {
-      Card* card = node->GetData();
+  SetHand( GetHand() | CardSet::Single( newcard->GetId() ) );
+  // Delay canvas placing until we reach the last card, so that the hand
+  // is shown sorted (card ids are ordered by suit, then by type)
+  if ( GetHand().Count() == MAX_CARDS ) {
+    Deck* deck = newcard->GetDeck();
+    for( CardSet left = GetHand(); !left.IsEmpty(); ) {
+      Card* card = deck->GetCard( left.PopFirst() );
       wxPoint pos = m_gamepos->NextPosition();
       canvas->Add( card, pos.x, pos.y, AreCardsHidden() );
       card->SetPlayable();
-      node = node->GetNext();
     }
   }
 }
@@ -216,12 +187,69 @@ char* BotPlayer::botnames[N_BOT_NAMES] = {
 
 bool BotPlayer::nameused[N_BOT_NAMES] = { false };
 
-BotPlayer::BotPlayer( GamePos* gamepos ):
-  Player( gamepos )
+BEGIN_EVENT_TABLE( BotPlayer, wxEvtHandler )
+  EVT_BOT_MOVE( BotPlayer::OnBotMove )
+END_EVENT_TABLE();
+
+// A bot choosing its card on a bot queue thread
+class BotMoveTask: public QueueTask
+{
+public:
+  BotMoveTask( BotPlayer* player, CardSet hand, const cardid_t* trick, int ntrick,
+               unsigned int ticket ):
+    m_player( player ), m_hand( hand ), m_ntrick( ntrick ), m_ticket( ticket )
+    { for( int i = 0; i < ntrick; i++ ) m_trick[i] = trick[i]; }
+  void Run()
+  {
+    {
+      std::lock_guard<std::mutex> lock( m_player->m_botmutex );
+      BotMoveEvt event( m_player->m_bot->PlayCard( m_hand, m_trick, m_ntrick ), m_ticket );
+      m_player->AddPendingEvent( event );
+    }
+    m_player->DoneThinking();
+  }
+private:
+  BotPlayer* m_player;
+  CardSet m_hand;
+  cardid_t m_trick[N_SEATS];
+  int m_ntrick;
+  unsigned int m_ticket;
+};
+
+// A bot thinking ahead on a bot queue thread
+class BotPonderTask: public QueueTask
+{
+public:
+  BotPonderTask( BotPlayer* player, CardSet hand, const cardid_t* trick, int ntrick,
+                 unsigned int id ):
+    m_player( player ), m_hand( hand ), m_ntrick( ntrick ), m_id( id )
+    { for( int i = 0; i < ntrick; i++ ) m_trick[i] = trick[i]; }
+  void Run()
+  {
+    {
+      std::lock_guard<std::mutex> lock( m_player->m_botmutex );
+      if( m_player->m_ponderid == m_id )
+        m_player->m_bot->Ponder( m_hand, m_trick, m_ntrick );
+    }
+    m_player->DoneThinking();
+  }
+private:
+  BotPlayer* m_player;
+  CardSet m_hand;
+  cardid_t m_trick[N_SEATS];
+  int m_ntrick;
+  unsigned int m_id;
+};
+
+BotPlayer::BotPlayer( GamePos* gamepos, Bot* bot ):
+  Player( gamepos ), m_bot( bot ), m_game( NULL ), m_leader( 0 ), m_tasks( 0 ),
+  m_pondering( false ), m_ponderid( 0 )
 {
   // Random name, avoiding repeated ones
+  // (bots are only created by the GUI thread)
+  static Rng rng( Rng::RandomSeed() );
   do {
-    nameind = (int)( (double)N_BOT_NAMES * rand() / ( RAND_MAX + 1.0 ) );
+    nameind = rng.Below( N_BOT_NAMES );
   } while( nameused[nameind] );  // N_BOT_NAMES should be >= 4 ;)
   nameused[nameind] = true;
   SetName( botnames[nameind] );
@@ -231,26 +259,87 @@ BotPlayer::~BotPlayer()
 {
   // "Free" the name
   nameused[nameind] = false;
+  // A move posted after this is dropped along with the handler
+  m_ponderid++;
+  m_bot->StopPondering();
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while( m_tasks )
+    m_done.wait( lock );
+  delete m_bot;
 }
 
-void BotPlayer::OnMyTurn( Game* game, const CardList& played )
+void BotPlayer::StartThinking()
 {
-  Card *toplay;
-  do {
-    toplay = PlayCard( & played );
-  } while( game->PlayMove( this, toplay ) != MOVE_OK );
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_tasks++;
+}
+
+void BotPlayer::DoneThinking()
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_tasks--;
+  m_done.notify_all();
+}
+
+void BotPlayer::NewGame( Game* game )
+{
+  m_game = game;
+  m_bot->NewGame( game->SeatOf( this ) );
 }
 
-// Dumb player implementation
-DumbPlayer::DumbPlayer( GamePos* gamepos ):
-  BotPlayer( gamepos ) {}
+void BotPlayer::NewRound( Card* trumph, Player* owner )
+{
+  // Also called when replacing a player in the middle of a trick
+  m_leader = m_game->GetEngine().GetLeader();
+  m_bot->NewRound( GetHand(), trumph->GetId(), m_game->SeatOf( owner ) );
+}
+
+void BotPlayer::Turn( Player* player, Card* card )
+{
+  if( !m_pondering )
+    return;
+  // The card pondered on came, searches on the others stop
+  m_pondering = false;
+  m_ponderid++;
+  m_bot->StopPondering( m_game->SeatOf( player ) == ( m_game->SeatOf( this ) + N_SEATS - 1 ) % N_SEATS ?
+                        card->GetId() : NO_CARD );
+}
+
+void BotPlayer::TurnEnd( const Player* winner, const CardList& played )
+{
+  cardid_t trick[N_SEATS];
+  int n = 0;
+  for( CardList::Node* node = played.GetFirst(); node; node = node->GetNext() )
+    trick[n++] = node->GetData()->GetId();
+  m_bot->TrickEnd( m_leader, trick );
+}
+
+void BotPlayer::OnMoveRequest( Game* game, const CardList& played, unsigned int ticket )
+{
+  cardid_t trick[N_SEATS];
+  int n = 0;
+  for( CardList::Node* node = played.GetFirst(); node; node = node->GetNext() )
+    trick[n++] = node->GetData()->GetId();
+  m_leader = game->GetEngine().GetLeader();
+  m_game = game;
+  StartThinking();
+  wxGetApp().GetBotQueue().Post( new BotMoveTask( this, GetHand(), trick, n, ticket ) );
+}
+
+void BotPlayer::OnPonder( Game* game, const CardList& played )
+{
+  cardid_t trick[N_SEATS];
+  int n = 0;
+  for( CardList::Node* node = played.GetFirst(); node; node = node->GetNext() )
+    trick[n++] = node->GetData()->GetId();
+  m_game = game;
+  m_pondering = true;
+  StartThinking();
+  wxGetApp().GetBotQueue().Post( new BotPonderTask( this, GetHand(), trick, n, ++m_ponderid ) );
+}
 
-Card* DumbPlayer::PlayCard( const CardList* played )
+void BotPlayer::OnBotMove( BotMoveEvt& event )
 {
-  Card *toplay;
-  CardList::Node* node = GetHand().GetFirst();
-  while( !IsValidMove( ( toplay = node->GetData() ), *played ) )
-    node = node->GetNext();
-  return toplay;
+  m_game->MoveReady( this, event.ticket, event.card );
 }
 
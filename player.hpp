@@ -30,16 +30,28 @@ class Player;
 class Team;
 class HumanPlayer;
 class LocalPlayer;
+class BotMoveEvt;
 class BotPlayer;
 class DumbPlayer;
+class PimcPlayer;
+class IsmctsPlayer;
 
 #ifndef MAX_CARDS
 #define MAX_CARDS 10
 #endif  // MAX_CARDS
 
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <wx/event.h>
 #include "mycanvas.hpp"
 #include "cards.hpp"
+#include "cardset.hpp"
+#include "bot.hpp"
+#include "pimcbot.hpp"
+#include "ismctsbot.hpp"
 #include "game.hpp"
+#include "myevents.hpp"
 
 // Game Layout
 // Canvas dimensions MC_X_SIZE, MC_Y_SIZE defined in mycanvas.hpp
@@ -137,7 +149,16 @@ public:
   virtual void NewTurn( Player* starter ) {}
   virtual void Turn( Player* player, Card* card ) {}
   virtual void TurnEnd( const Player* winner, const CardList& played ) {}
+  // Asked as soon as this player is next, maybe before the table is
+  // ready for its card: players that think can answer early with
+  // Game::MoveReady and the same ticket
+  virtual void OnMoveRequest( Game* game, const CardList& played, unsigned int ticket ) {}
+  // The table waits for this player's card
   virtual void OnMyTurn( Game* game, const CardList& played ) = 0;
+  // The seat before this one is to play a card it takes its time over
+  // (e.g. a human's), for players that think ahead meanwhile
+  virtual void OnPonder( Game* game, const CardList& played ) {}
+  virtual bool IsBot() const { return false; }
   virtual void AddToHand( Card* newcard, MyCanvas* canvas );
   wxString& GetName() { return m_name; }
   void SetName( const wxString& name ) { m_name = name; }
@@ -150,8 +171,9 @@ public:
   wxPoint GetPlayPos() { return m_gamepos->PlayedCardPos(); }
   wxPoint GetCollectPos() { return m_gamepos->CollectPos(); }
   bool IsValidMove( const Card* card, const CardList& played );
-  void Remove( Card* card ) { GetHand().DeleteObject( card ); }
-  CardList& GetHand() const { return (CardList&)m_hand; }
+  void Remove( Card* card ) { m_hand.Remove( card->GetId() ); }
+  CardSet GetHand() const { return m_hand; }
+  void SetHand( CardSet hand ) { m_hand = hand; }
   void SetGamePos( GamePos* newpos );
   GamePos* GetGamePos() const { return m_gamepos; }
   GamePos* GetGamePosCopy() const { return m_gamepos->Clone(); }
@@ -161,18 +183,18 @@ protected:
   wxString m_name;
 private:
   Team* m_team;
-  CardList m_hand;
+  CardSet m_hand;
 };
 
 // Player team
 class Team {
 public:
   Team( Player* np1, Player* np2 );
-  unsigned short GetRoundPoints() const { return m_points; }
+  unsigned short GetRoundPoints() const { return captured.Points(); }
   void AddToWon( unsigned short won ) { m_won += won; }
   unsigned short GetWon() const { return m_won; }
   void AddToCapt( CardList& cards );
-  const CardList& GetCapt() const { return captured; }
+  CardSet GetCapt() const { return captured; }
   void NewRound( Card* trumph, Player* owner );
   bool Belongs( Player *player ) const { return player == p1 || player == p2; }
   Player* GetP1() const { return p1; }
@@ -182,10 +204,9 @@ public:
   bool Replace( Player* oldplayer, Player* newplayer );
 private:
   unsigned short m_won;
-  unsigned short m_points;
   Player* p1;
   Player* p2;
-  CardList captured;
+  CardSet captured;
   wxString wonstr;
 };
 
@@ -203,27 +224,85 @@ public:
   void AddToHand( Card* newcard, MyCanvas* canvas );
 };
 
-// Computer player (abstract class)
+#define EVT_BOT_MOVE(func) DECLARE_EVENT_TABLE_ENTRY( BOT_MOVE_TYPE, wxID_ANY, wxID_ANY, ( wxObjectEventFunction ) & func, (wxObject *) NULL ),
+
+// Card chosen by a bot, posted back to its player from the thread
+// where it thought
+class BotMoveEvt: public wxEvent
+{
+public:
+  cardid_t card;
+  unsigned int ticket;  // Of the move request
+  BotMoveEvt( cardid_t the_card, unsigned int the_ticket ):
+    wxEvent( 0, BOT_MOVE_TYPE ), card( the_card ), ticket( the_ticket ) {}
+  wxEvent *Clone(void) const { return new BotMoveEvt( *this ); }
+};
+
+// Computer player, shows a headless bot on the GUI
+// The bot thinks on the application bot queue as soon as the move is
+// requested, and its card comes back as a BotMoveEvt, so the GUI
+// (painting, network) runs on meanwhile. It ponders there too, while
+// the seat before decides, one task at a time using the bot.
 // N_BOT_NAMES should match the number of bot names in player.cpp
 #define N_BOT_NAMES 14
-class BotPlayer: public Player {
+class BotPlayer: public Player, public wxEvtHandler {
 public:
-  BotPlayer( GamePos* gamepos );
+  // The bot is owned (and deleted) by the player
+  BotPlayer( GamePos* gamepos, Bot* bot );
   virtual ~BotPlayer();
-  void OnMyTurn( Game* game, const CardList& played );
-  virtual Card* PlayCard( const CardList* played ) = 0;
+  void NewGame( Game* game );
+  void NewRound( Card* trumph, Player* owner );
+  void Turn( Player* player, Card* card );
+  void TurnEnd( const Player* winner, const CardList& played );
+  void OnMoveRequest( Game* game, const CardList& played, unsigned int ticket );
+  // The card was asked for already
+  void OnMyTurn( Game* game, const CardList& played ) {}
+  void OnPonder( Game* game, const CardList& played );
+  bool IsBot() const { return true; }
+  void OnBotMove( BotMoveEvt& event );
 private:
+  friend class BotMoveTask;
+  friend class BotPonderTask;
+  void StartThinking();
+  void DoneThinking();
+  Bot* m_bot;
+  Game* m_game;
+  int m_leader;  // Seat that led the current trick
   int nameind;
+  // Tasks posted for the bot, which must be over before it can be
+  // deleted, and the lock they take to use it
+  std::mutex m_mutex;
+  std::condition_variable m_done;
+  int m_tasks;
+  std::mutex m_botmutex;
+  // Pondering asked for this turn, and which request it is (a task
+  // for an older one has nothing left to do)
+  bool m_pondering;
+  std::atomic<unsigned int> m_ponderid;
   static char* botnames[N_BOT_NAMES];
   static bool nameused[N_BOT_NAMES];
+  DECLARE_EVENT_TABLE();
 };
 
 // Specific computer players
 // Dumb player: plays first available card
 class DumbPlayer: public BotPlayer {
 public:
-  DumbPlayer( GamePos* gamepos );
-  Card* PlayCard( const CardList* played );
+  DumbPlayer( GamePos* gamepos ): BotPlayer( gamepos, new DumbBot() ) {}
+};
+
+// Monte Carlo player: solves many guesses of the other hands, on all cores
+class PimcPlayer: public BotPlayer {
+public:
+  PimcPlayer( GamePos* gamepos, int budget = PIMC_BUDGET ):
+    BotPlayer( gamepos, new PimcBot( 0, budget ) ) {}
+};
+
+// Tree search player: the alternative to the Monte Carlo one, on all cores
+class IsmctsPlayer: public BotPlayer {
+public:
+  IsmctsPlayer( GamePos* gamepos, int budget = ISMCTS_BUDGET ):
+    BotPlayer( gamepos, new IsmctsBot( 0, budget, 16 * ISMCTS_ITERATIONS ) ) {}
 };
 
 #endif // _PLAYER_HPP_
@@ -0,0 +1,125 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <cmath>
+#include <vector>
+#include "playmodel.hpp"
+#include "trick.hpp"
+
+// Play model implementation
+void PlayModel::TrickEnd( int leader, const cardid_t* played )
+{
+  if( m_ntricks == MAX_CARDS )
+    return;
+  for( int i = 0; i < N_SEATS; i++ )
+    m_tricks[m_ntricks][i] = played[i];
+  m_leaders[m_ntricks++] = leader;
+}
+
+// Log of the chance the reference policy plays the card, from the hand
+// (which still has it) after the first n cards of the trick
+double PlayModel::LogChance( cardid_t card, CardSet hand, const cardid_t* trick, int n ) const
+{
+  if( !n )
+    return 0;  // Leads tell little without knowing the plan
+  CardSet legal = Engine::LegalMoves( hand, trick[0] );
+  int winner = TrickWinnerSoFar( trick, n, m_trumph );
+  cardid_t winning = trick[winner];
+  bool partner = ( n - winner ) % 2 == 0;
+  double sum = 0, chosen = 0;
+  while( !legal.IsEmpty() ) {
+    cardid_t move = legal.PopFirst();
+    cardsuit_t suit = CardIdSuit( move );
+    int rank = CardIdRank( move );
+    int value = CardIdValue( move );
+    double score;
+    if( partner )
+      score = value;  // Give points to the partner
+    else if( ( suit == CardIdSuit( winning ) && rank > CardIdRank( winning ) ) ||
+             ( suit == m_trumph && CardIdSuit( winning ) != m_trumph ) )
+      score = 12 - 0.1 * rank;  // Win, with the cheapest card
+    else
+      score = -value - 0.1 * rank;  // Throw away the cheapest card
+    double weight = exp( m_sharpness * score );
+    sum += weight;
+    if( move == card )
+      chosen = weight;
+  }
+  return log( chosen / sum );
+}
+
+double PlayModel::LogLikelihood( int observer, const CardSet* hands, int leader,
+                                 const cardid_t* played, int nplayed ) const
+{
+  // Go back in time, giving the players back the cards they played
+  CardSet held[N_SEATS];
+  for( int seat = 0; seat < N_SEATS; seat++ )
+    held[seat] = hands[seat];
+  for( int i = 0; i < nplayed; i++ )
+    held[( leader + i ) % N_SEATS].Add( played[i] );
+  double loglike = 0;
+  for( int i = 1; i < nplayed; i++ ) {
+    int seat = ( leader + i ) % N_SEATS;
+    if( seat != observer )
+      loglike += LogChance( played[i], held[seat], played, i );
+  }
+  for( int t = m_ntricks - 1; t >= 0; t-- ) {
+    const cardid_t* trick = m_tricks[t];
+    for( int i = 0; i < N_SEATS; i++ )
+      held[( m_leaders[t] + i ) % N_SEATS].Add( trick[i] );
+    for( int i = 1; i < N_SEATS; i++ ) {
+      int seat = ( m_leaders[t] + i ) % N_SEATS;
+      if( seat != observer )
+        loglike += LogChance( trick[i], held[seat], trick, i );
+    }
+  }
+  return loglike;
+}
+
+void PlayModel::Resample( const DealSampler& sampler, Rng& rng, int observer, int leader,
+                          const cardid_t* played, int nplayed, CardSet* worlds, int n,
+                          int candidates ) const
+{
+  std::vector<CardSet> deals( candidates * N_SEATS );
+  std::vector<double> weights( candidates );
+  sampler.SampleBatch( rng, &deals[0], candidates );
+  double best = -HUGE_VAL;
+  for( int i = 0; i < candidates; i++ ) {
+    weights[i] = LogLikelihood( observer, &deals[i * N_SEATS], leader, played, nplayed );
+    if( weights[i] > best )
+      best = weights[i];
+  }
+  double total = 0;
+  for( int i = 0; i < candidates; i++ ) {
+    // Plain uniform deals if the model can explain none of them
+    weights[i] = best == -HUGE_VAL ? 1 : exp( weights[i] - best );
+    total += weights[i];
+  }
+  // Systematic resampling: n evenly spaced points over the weights
+  double step = total / n;
+  double point = step * ( rng.Next() >> 11 ) * ( 1.0 / ( (uint64_t)1 << 53 ) );
+  double sum = weights[0];
+  int c = 0;
+  for( int i = 0; i < n; i++, point += step ) {
+    while( point >= sum && c < candidates - 1 )
+      sum += weights[++c];
+    for( int seat = 0; seat < N_SEATS; seat++ )
+      worlds[i * N_SEATS + seat] = deals[c * N_SEATS + seat];
+  }
+}
@@ -0,0 +1,65 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _PLAYMODEL_HPP_
+#define _PLAYMODEL_HPP_ 1
+
+// Forward declarations
+class PlayModel;
+
+#include "engine.hpp"
+#include "dealsampler.hpp"
+#include "rng.hpp"
+
+#define PLAYMODEL_SHARPNESS 0.3  // How sure the model is of its choices
+
+// Soft information from the cards the other seats chose to play.
+// A simple reference policy (throw away cheap cards, win with cheap
+// cards, give points to a partner who is winning) tells how likely
+// each play was given the hand the player would have had in a world,
+// and worlds are weighted by the likelihood of all the plays seen.
+// E.g. a seat that discarded an Ace is unlikely to have had cheaper
+// cards to discard.
+class PlayModel
+{
+public:
+  PlayModel( double sharpness = PLAYMODEL_SHARPNESS ):
+    m_sharpness( sharpness ), m_ntricks( 0 ), m_trumph( CLUBS ) {}
+  void NewRound( cardsuit_t trumph ) { m_trumph = trumph; m_ntricks = 0; }
+  // Cards of a complete trick, starting with the leader's
+  void TrickEnd( int leader, const cardid_t* played );
+  // Log of the likelihood of the plays of every seat but the observer,
+  // in the tricks seen and in the current one, had the hands been these
+  double LogLikelihood( int observer, const CardSet* hands, int leader,
+                        const cardid_t* played, int nplayed ) const;
+  // Fills worlds with n deals (N_SEATS hands each) drawn from candidates
+  // uniform deals of the sampler, in proportion to their likelihood
+  void Resample( const DealSampler& sampler, Rng& rng, int observer, int leader,
+                 const cardid_t* played, int nplayed, CardSet* worlds, int n,
+                 int candidates ) const;
+private:
+  double LogChance( cardid_t card, CardSet hand, const cardid_t* trick, int n ) const;
+  double m_sharpness;
+  cardid_t m_tricks[MAX_CARDS][N_SEATS];  // Seen this round
+  unsigned char m_leaders[MAX_CARDS];
+  int m_ntricks;
+  cardsuit_t m_trumph;
+};
+
+#endif  // _PLAYMODEL_HPP_
@@ -24,6 +24,7 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include <wx/msgdlg.h>
 #include "main.hpp"
 #include "netcommon.hpp"
+#include "bot.hpp"
 
 // Preferences dialog implementation
 BEGIN_EVENT_TABLE( PrefsDialog, wxDialog )
@@ -47,6 +48,19 @@ PrefsDialog::PrefsDialog( wxWindow* parent ):
   delay_entry = new wxSlider( this, wxID_ANY, wxGetApp().GetUpdateDelay(), 1, 10, wxDefaultPosition, wxSize(100, wxID_ANY), wxSL_HORIZONTAL | wxSL_LABELS | wxSL_AUTOTICKS );
   delay_sizer->Add( delay_entry, 0, wxALIGN_CENTER );
 
+  // Computer players strength, as their time to think
+  wxBoxSizer* level_sizer = new wxBoxSizer( wxHORIZONTAL );
+  level_sizer->Add( new wxStaticText( this, wxID_ANY, "Computer players level" ), 0, wxRIGHT | wxALIGN_CENTER, 5 );
+  level_entry = new wxChoice( this, wxID_ANY );
+  for( int i = 0; i < N_BOT_LEVELS; i++ )
+    level_entry->Append( wxString::Format( "%s (%d ms)", Bot::level_names[i], Bot::level_budgets[i] ) );
+  level_entry->SetSelection( wxGetApp().GetBotLevel() );
+  level_sizer->Add( level_entry, 0, wxALIGN_CENTER );
+
+  // Solved endgames, mapped at startup only
+  endgame_entry = new wxCheckBox( this, wxID_ANY, "Use endgame table (from next start)" );
+  endgame_entry->SetValue( wxGetApp().GetUseEndgameTable() );
+
   // Buttons
   wxBoxSizer* button_sizer = new wxBoxSizer( wxHORIZONTAL );
   wxButton* ok_button = new wxButton( this, wxID_OK, "OK" );
@@ -58,6 +72,8 @@ PrefsDialog::PrefsDialog( wxWindow* parent ):
   wxBoxSizer* top_sizer = new wxBoxSizer( wxVERTICAL );
   top_sizer->Add( name_sizer, 0, wxBOTTOM, 10 );
   top_sizer->Add( delay_sizer, 0, wxBOTTOM, 10 );
+  top_sizer->Add( level_sizer, 0, wxBOTTOM, 10 );
+  top_sizer->Add( endgame_entry, 0, wxBOTTOM, 10 );
   top_sizer->Add( button_sizer, 0, wxTOP | wxALIGN_CENTER_HORIZONTAL, 5 );
 
   // Invisible border
@@ -82,6 +98,8 @@ void PrefsDialog::OnOk( wxCommandEvent& event )
 
   app.SetLocalPlayerName( newname );
   app.SetUpdateDelay( delay_entry->GetValue() );
+  app.SetBotLevel( level_entry->GetSelection() );
+  app.SetUseEndgameTable( endgame_entry->GetValue() );
   Done( event );
 }
 
@@ -26,6 +26,8 @@ class PrefsDialog;
 #include <wx/dialog.h>
 #include <wx/textctrl.h>
 #include <wx/slider.h>
+#include <wx/choice.h>
+#include <wx/checkbox.h>
 
 // Dialog with game options
 class PrefsDialog: public wxDialog
@@ -35,6 +37,8 @@ public:
 private:
   wxTextCtrl* name_entry;
   wxSlider* delay_entry;
+  wxChoice* level_entry;
+  wxCheckBox* endgame_entry;
   void OnOk( wxCommandEvent& event );
   void Done( wxCommandEvent& event );
   DECLARE_EVENT_TABLE();
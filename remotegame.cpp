@@ -55,14 +55,12 @@ void RemoteGame::PlayRemoteMove( Player *player, Card *card )
   // Make sure only one card at a time is seen played
   while( ! playtime )
     wxGetApp().Yield();
-  if( player == localplayer ) {
-    player->Remove( card );
-    card->SetPlayable( false );
-  }
-  else {
+  int p;
+  for( p = 0; p < 3 && fake_players[p] != player; p++ );
+  if( p < 3 ) {
     // Pick a random fake card from the player's hand
-    CardList& hand = player->GetHand();
-    int rindex = (int)( hand.GetCount() * rand() / ( RAND_MAX + 1.0 ) );
+    CardList& hand = fake_cards[p];
+    int rindex = m_engine.GetRng().Below( hand.GetCount() );
     CardList::Node* node = hand.Item( rindex );
     Card* fake_card = node->GetData();
     // Move the card to the fake one's position
@@ -73,14 +71,12 @@ void RemoteGame::PlayRemoteMove( Player *player, Card *card )
     delete fake_card;
     canvas->Add( card, pos.x, pos.y, false );
   }
-  m_played.Append( card );
-  playtime = false; // TODO!!!!
-  canvas->MoveCardTo( card, player->GetPlayPos() );
+  // The server already checked the move, the engine just follows it
+  m_engine.ForceMove( SeatOf( player ), card->GetId() );
 }
 
 void RemoteGame::NewRound( Card* trumph, Player* owner, CardList& localcards )
 {
-  turns_left = 10;
   // Cards for localplayer
   for( CardList::Node* node = localcards.GetFirst();
        node;
@@ -89,35 +85,21 @@ void RemoteGame::NewRound( Card* trumph, Player* owner, CardList& localcards )
   // Fake cards for the remote players, as we don't know their game
   for( int p = 0; p < 3; p++ ) {
     Player* pl = fake_players[p];
-    for( int i = 0; i < MAX_CARDS; i++ )
-      pl->AddToHand( new Card( *m_deck.nulcard ), canvas );
+    for( int i = 0; i < MAX_CARDS; i++ ) {
+      Card* fake_card = new Card( *m_deck.nulcard );
+      fake_cards[p].Append( fake_card );
+      pl->AddToHand( fake_card, canvas );
+    }
   }
-  m_trumph = trumph;
-  // Each team instance tells its players a new round is starting
-  trumph_owner = owner;
-  team1->NewRound( m_trumph, trumph_owner );
-  team2->NewRound( m_trumph, trumph_owner );
-  canvas->SetTrumphLabel( trumph_owner, m_trumph );
-  trumphdlg->UpdateTrumph( m_trumph, trumph_owner );
-  //Player* first = m_roundpos->GetNext();
+  // Hands are not known to our engine, so it will only follow the tricks
+  m_engine.StartRound( trumph->GetId(), SeatOf( owner ) );
   playtime = true;
-  //PassTurn( first );
 }
 
 void RemoteGame::EndTurn( Player* winner )
 {
-  winner->GetTeam()->AddToCapt( m_played );
-  score->UpdateRoundResults();
-  // Collect cards
-  m_cards_to_collect = 4;
-  CardList::Node* node = m_played.GetFirst();
-  while( node ) {
-    // Add events
-    canvas->MoveCardTo( node->GetData(), winner->GetCollectPos() );
-    node = node->GetNext();
-  }
-  m_played.Clear();
-  turns_left--;
+  // The engine finds the same winner as the server
+  m_engine.EndTrick();
 }
 
 void RemoteGame::SetPlayerName( Player* player, const wxString& newname )
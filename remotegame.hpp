@@ -52,6 +52,7 @@ private:
   RemoteHandler* m_handler;
   LocalPlayer* localplayer;
   HumanPlayer* fake_players[3];
+  CardList fake_cards[3];
 };
 
 #endif // _REMOTEGAME_HPP_
@@ -0,0 +1,31 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <atomic>
+#include <chrono>
+#include "rng.hpp"
+
+uint64_t Rng::RandomSeed()
+{
+  // The counter keeps seeds apart when the clock is too coarse
+  static std::atomic<uint64_t> counter( 0 );
+  uint64_t seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+  seed ^= counter.fetch_add( 1 ) * 0x9e3779b97f4a7c15ULL;
+  return SplitMix( seed );
+}
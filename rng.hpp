@@ -0,0 +1,100 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _RNG_HPP_
+#define _RNG_HPP_ 1
+
+// Forward declarations
+class Rng;
+
+#include <stdint.h>
+
+// Small and fast pseudo random number generator (xoshiro256**).
+// Not thread safe: every game or thread should own one, seeded with
+// its own seed (e.g. a base seed plus the thread number).
+class Rng
+{
+public:
+  Rng( uint64_t seed = 0 ) { Seed( seed ); }
+  void Seed( uint64_t seed )
+  {
+    // Expand the seed with splitmix64, which never gives an all zero state
+    for( int i = 0; i < 4; i++ )
+      m_s[i] = SplitMix( seed );
+  }
+  uint64_t Next()
+  {
+    uint64_t result = Rotl( m_s[1] * 5, 7 ) * 9;
+    uint64_t t = m_s[1] << 17;
+    m_s[2] ^= m_s[0];
+    m_s[3] ^= m_s[1];
+    m_s[1] ^= m_s[2];
+    m_s[0] ^= m_s[3];
+    m_s[2] ^= t;
+    m_s[3] = Rotl( m_s[3], 45 );
+    return result;
+  }
+  // Uniform number in [0, n), without modulo bias (Lemire's method)
+  uint32_t Below( uint32_t n )
+  {
+    uint64_t m = ( Next() >> 32 ) * n;
+    if( (uint32_t)m < n ) {
+      uint32_t threshold = -n % n;
+      while( (uint32_t)m < threshold )
+        m = ( Next() >> 32 ) * n;
+    }
+    return (uint32_t)( m >> 32 );
+  }
+  // Same for 64 bit ranges
+  uint64_t Below64( uint64_t n )
+  {
+    unsigned __int128 m = (unsigned __int128)Next() * n;
+    if( (uint64_t)m < n ) {
+      uint64_t threshold = -n % n;
+      while( (uint64_t)m < threshold )
+        m = (unsigned __int128)Next() * n;
+    }
+    return (uint64_t)( m >> 64 );
+  }
+  // Fisher-Yates shuffle
+  template<class T> void Shuffle( T* items, int n )
+  {
+    for( int i = n - 1; i > 0; i-- ) {
+      int j = Below( i + 1 );
+      T t = items[i];
+      items[i] = items[j];
+      items[j] = t;
+    }
+  }
+  // A seed that differs on every call, for games that need not be
+  // reproducible
+  static uint64_t RandomSeed();
+private:
+  static uint64_t Rotl( uint64_t x, int k ) { return ( x << k ) | ( x >> ( 64 - k ) ); }
+  static uint64_t SplitMix( uint64_t& x )
+  {
+    uint64_t z = ( x += 0x9e3779b97f4a7c15ULL );
+    z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+    z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebULL;
+    return z ^ ( z >> 31 );
+  }
+  uint64_t m_s[4];
+};
+
+#endif  // _RNG_HPP_
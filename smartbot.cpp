@@ -0,0 +1,164 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include "smartbot.hpp"
+#include "canonical.hpp"
+#include "zobrist.hpp"
+
+// Smart bot implementation
+void SmartBot::NewRound( CardSet hand, cardid_t newtrumph, int newowner )
+{
+  trumph = newtrumph;
+  trumphowner = newowner;
+  for( int i = 0; i < 3; i++ )
+    for( int j = 0; j < 4; j++ ) {
+      plhasnot[i][j] = false;
+      released[i][j] = 0;
+    }
+  out.Clear();
+  n_seen = 0;
+  // Group hand by suit
+  for( int i = SUITMIN; i <= SUITMAX; i++ ) {
+    n_out[i] = 0;
+    bysuit[i] = hand.InSuit( (cardsuit_t)i );
+  }
+}
+
+void SmartBot::TrickEnd( int leader, const cardid_t* played )
+{
+  // Memorize cards that have been played
+  cardsuit_t firstsuit = CardIdSuit( played[0] );
+  for( int i = 0; i < N_SEATS; i++ ) {
+    cardid_t card = played[i];
+    cardsuit_t suit_i = CardIdSuit( card );
+    out.Add( card );
+    seen[n_seen++] = card;
+    n_out[suit_i]++;
+    plindex_t pli;
+    if( ( pli = PlayerIndex( ( leader + i ) % N_SEATS ) ) != SBOT_THIS ) {
+      released[pli][suit_i]++;
+      if( suit_i != firstsuit )  // Did not follow, so has none left
+	plhasnot[pli][firstsuit] = true;
+    }
+    else  // Remove the card we played from our list
+      bysuit[suit_i].Remove( card );
+  }
+}
+
+cardid_t SmartBot::PlayCard( CardSet hand, const cardid_t* played, int nplayed )
+{
+  cardsuit_t trumphsuit = CardIdSuit( trumph );
+
+  if( !nplayed ) {
+    // We are the first to play
+    // Start by trying our best non-trumph cards
+    for( int thissuit = SUITMIN; thissuit <= SUITMAX; thissuit++ ) {
+      if( thissuit == trumphsuit ||
+	  released[SBOT_LEFT][thissuit] > 1 ||
+	  released[SBOT_RIGHT][thissuit] > 1 ||
+	  n_out[thissuit] > 4 )
+	continue;
+      if( ! bysuit[thissuit].IsEmpty() ) {
+	cardid_t card = bysuit[thissuit].Last();
+	switch( cardtype_t cardtp = CardIdType( card ) ) {
+	case ACE:
+	  if(  !plhasnot[SBOT_LEFT][cardtp] && !plhasnot[SBOT_RIGHT][cardtp] )
+	    return card;
+	  break;
+	case SEVEN:
+	  // FIXME: this check never took effect (stray ';'), so sevens
+	  // are always led. Kept as is to not change the bot's play.
+	  //if( !plhasnot[SBOT_LEFT][cardtp] && !plhasnot[SBOT_RIGHT][cardtp] &&
+	  //    IsOut( ACE, (cardsuit_t)thissuit ) )
+	  return card;
+	default:
+	  break;
+	}
+      }
+    }
+    // Try a trumph card
+    if( ! bysuit[trumphsuit].IsEmpty() )
+      return bysuit[trumphsuit].Last();
+  }
+  // TODO: following a lead
+  // Awful game right now... play anything, like a dumb player
+  return Engine::LegalMoves( hand, nplayed ? played[0] : NO_CARD ).First();
+}
+
+uint64_t SmartBot::InfosetKey( CardSet hand, const cardid_t* played, int nplayed,
+                              unsigned char* suits ) const
+{
+  uint64_t key = MixBits( CanonicalHand( hand, CardIdSuit( trumph ), suits ).GetMask() );
+  // The whole history: with the first leader (after the trumph owner)
+  // it tells who played each card, which the PlayModel weighs
+  for( int i = 0; i < n_seen; i++ ) {
+    cardid_t card = suits[CardIdSuit( seen[i] )] * N_RANKS + CardIdRank( seen[i] );
+    key = MixBits( key ^ ( (uint64_t)( i + 1 ) << 48 ) ^ card );
+  }
+  for( int i = 0; i < nplayed; i++ ) {
+    cardid_t card = suits[CardIdSuit( played[i] )] * N_RANKS + CardIdRank( played[i] );
+    key = MixBits( key ^ ( (uint64_t)( i + 1 ) << 56 ) ^ card );
+  }
+  // Voids by seat after this one and canonical suit, then the trumph
+  // card and its owner
+  uint64_t known = 0;
+  for( int i = 0; i < 3; i++ )
+    for( int suit = 0; suit < N_SUITS; suit++ )
+      if( plhasnot[i][suit] )
+        known |= (uint64_t)1 << ( i * N_SUITS + suits[suit] );
+  cardid_t shown = suits[CardIdSuit( trumph )] * N_RANKS + CardIdRank( trumph );
+  known |= (uint64_t)shown << 12 | (uint64_t)PlayerIndex( trumphowner ) << 20 |
+    (uint64_t)nplayed << 24;
+  key = MixBits( key ^ known );
+  return key ? key : 1;
+}
+
+bool SmartBot::SetupSampler( DealSampler& sampler, CardSet hand, const cardid_t* played,
+                             int nplayed, int tomove ) const
+{
+  // What every other seat must hold, and the suits it has none of
+  if( tomove < 0 )
+    tomove = m_seat;
+  int leader = ( tomove + N_SEATS - nplayed ) % N_SEATS;
+  CardSet unseen = ~( out | hand );
+  CardSet hands[N_SEATS];
+  int room[N_SEATS];
+  bool voids[N_SEATS][N_SUITS];
+  for( int seat = 0; seat < N_SEATS; seat++ ) {
+    room[seat] = hand.Count();
+    for( int suit = 0; suit < N_SUITS; suit++ )
+      voids[seat][suit] = seat != m_seat && plhasnot[PlayerIndex( seat )][suit];
+  }
+  for( int i = 0; i < nplayed; i++ ) {
+    int seat = ( leader + i ) % N_SEATS;
+    unseen.Remove( played[i] );
+    room[seat]--;
+    if( CardIdSuit( played[i] ) != CardIdSuit( played[0] ) )
+      voids[seat][CardIdSuit( played[0] )] = true;
+  }
+  hands[m_seat] = hand;
+  room[m_seat] = 0;
+  // The trumph card was shown, its owner has it until it is played
+  if( unseen.Contains( trumph ) ) {
+    hands[trumphowner].Add( trumph );
+    unseen.Remove( trumph );
+    room[trumphowner]--;
+  }
+  return sampler.Setup( hands, unseen, room, voids ) != 0;
+}
@@ -0,0 +1,65 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _SMARTBOT_HPP_
+#define _SMARTBOT_HPP_ 1
+
+// Forward declarations
+class SmartBot;
+
+#include "bot.hpp"
+#include "dealsampler.hpp"
+
+// Smart bot: tries to be a good player
+enum plindex_t { SBOT_RIGHT = 0, SBOT_PARTNER, SBOT_LEFT, SBOT_THIS };
+class SmartBot: public Bot
+{
+public:
+  void NewRound( CardSet hand, cardid_t newtrumph, int newowner );
+  void TrickEnd( int leader, const cardid_t* played );
+  cardid_t PlayCard( CardSet hand, const cardid_t* played, int nplayed );
+  // Prepares the sampler to deal the unseen cards in the ways that agree
+  // with what was seen so far, false if there is none. The seat to play
+  // is this bot's by default, else one before it in the trick.
+  bool SetupSampler( DealSampler& sampler, CardSet hand, const cardid_t* played,
+                     int nplayed, int tomove = -1 ) const;
+  // Hash of what the bot knows when it is to play (its hand, the cards
+  // played this round in order, and so who played which, the trick, the
+  // suits others have none of, where the trumph is), never 0. The suits
+  // are relabeled as by CanonicalHand(), suits gets the canonical suit of
+  // each one.
+  uint64_t InfosetKey( CardSet hand, const cardid_t* played, int nplayed,
+                       unsigned char* suits ) const;
+protected:
+  CardSet out;
+  int n_out[4];
+  CardSet bysuit[4];
+  int trumphowner;
+  cardid_t trumph;
+  bool plhasnot[3][12];
+  unsigned short released[3][4];
+  cardid_t seen[N_CARDS];  // Cards of the tricks over, in the order played
+  int n_seen;
+  plindex_t PlayerIndex( int seat ) const
+    { return (plindex_t)( ( seat - m_seat + N_SEATS - 1 ) % N_SEATS ); }
+  bool IsOut( cardtype_t type_id, cardsuit_t suit_id ) const
+    { return out.Contains( MakeCardId( suit_id, type_id ) ); }
+};
+
+#endif  // _SMARTBOT_HPP_
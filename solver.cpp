@@ -0,0 +1,464 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include "solver.hpp"
+#include "canonical.hpp"
+
+#define N_POINTS 120  // In a whole round
+#define NO_VALUE 1000  // Beyond any number of points
+
+// Search limit implementation
+void SearchLimit::Start( int budget, unsigned long maxnodes )
+{
+  m_budget = budget;
+  m_maxnodes = maxnodes;
+  m_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds( budget );
+  m_nodes.store( 0, std::memory_order_relaxed );
+  m_over.store( false, std::memory_order_relaxed );
+}
+
+bool SearchLimit::Check( unsigned long nodes )
+{
+  unsigned long total = m_nodes.fetch_add( nodes, std::memory_order_relaxed ) + nodes;
+  if( ( m_maxnodes && total >= m_maxnodes ) ||
+      ( m_budget && std::chrono::steady_clock::now() >= m_deadline ) )
+    m_over.store( true, std::memory_order_relaxed );
+  return IsOver();
+}
+
+// Solver implementation
+Solver::Solver( int tablebits ):
+  m_horizon( 0 ), m_nodes( 0 ), m_table( new TransTable( tablebits ) ), m_owntable( true ),
+  m_endgame( &endgame_table ), m_endgamehits( 0 ), m_limit( NULL ), m_aborted( false )
+{
+}
+
+Solver::Solver( TransTable& table ):
+  m_horizon( 0 ), m_nodes( 0 ), m_table( &table ), m_owntable( false ),
+  m_endgame( &endgame_table ), m_endgamehits( 0 ), m_limit( NULL ), m_aborted( false )
+{
+}
+
+Solver::~Solver()
+{
+  if( m_owntable )
+    delete m_table;
+}
+
+void Solver::SetPosition( const CardSet* hands, cardsuit_t trumph, int leader,
+                          const cardid_t* trick, int ntrick )
+{
+  m_state.Set( hands, trumph, leader, trick, ntrick );
+  m_aborted = false;
+}
+
+void Solver::SetPosition( const Engine& engine )
+{
+  m_state.Set( engine );
+  m_aborted = false;
+}
+
+void Solver::SetPosition( const GameState& state )
+{
+  m_state = state;
+  m_aborted = false;
+}
+
+// MTD(f): null window searches converging on the value, which
+// the transposition table makes much cheaper than a full window one
+int Solver::Solve()
+{
+  int lower = 0, upper = N_POINTS;
+  int value = N_POINTS / 2;
+  while( lower < upper && !m_aborted ) {
+    int beta = value == lower ? value + 1 : value;
+    value = Search( beta - 1, beta );
+    if( value < beta )
+      upper = value;
+    else
+      lower = value;
+  }
+  return value;
+}
+
+int Solver::SolveMove( cardid_t card )
+{
+  int gain = Play( card );
+  int value = gain + Solve();
+  m_state.Undo( card );
+  return value;
+}
+
+cardid_t Solver::BestMove( int* value )
+{
+  cardid_t moves[MAX_CARDS];
+  int n = OrderMoves( moves );
+  bool maximize = Engine::TeamOf( m_state.GetTurn() ) == 0;
+  cardid_t best = moves[0];
+  int bestvalue = SolveMove( best );
+  for( int i = 1; i < n; i++ ) {
+    // A null window search tells whether the move is any better,
+    // only then is its exact value needed
+    int gain = Play( moves[i] );
+    int bound = bestvalue - gain;
+    int v = gain + ( maximize ? Search( bound, bound + 1 ) : Search( bound - 1, bound ) );
+    if( maximize ? v > bestvalue : v < bestvalue ) {
+      bestvalue = gain + Solve();
+      best = moves[i];
+    }
+    m_state.Undo( moves[i] );
+  }
+  if( value )
+    *value = bestvalue;
+  return best;
+}
+
+// Fail-soft alpha-beta, team 0 maximizes
+int Solver::Search( int alpha, int beta )
+{
+  m_nodes++;
+  if( m_limit ) {
+    if( m_nodes % LIMIT_CHECK_NODES == 0 && m_limit->Check( LIMIT_CHECK_NODES ) )
+      m_aborted = true;
+    // Unwind as fast as possible, nothing is stored on the way
+    if( m_aborted )
+      return 0;
+  }
+  bool usetable = false;
+  int depth = 0;
+  uint64_t hash = 0;
+  int value;
+  CanonicalPosition canonical;
+  TableEntry entry;
+  entry.move = NO_CARD;
+  cardid_t first = NO_CARD;
+  if( m_state.GetPlayedCount() == 0 ) {
+    if( m_state.IsRoundOver() )
+      return 0;
+    // Nothing to decide if the window is out of the possible values
+    if( beta <= 0 )
+      return 0;
+    int total = m_state.GetInPlay().Points();
+    if( alpha >= total )
+      return total;
+    // The last trick plays itself
+    if( m_state.GetTricksLeft() == 1 ) {
+      cardid_t trick[N_SEATS];
+      int leader = m_state.GetLeader();
+      for( int i = 0; i < N_SEATS; i++ )
+        trick[i] = m_state.GetHand( ( leader + i ) % N_SEATS ).First();
+      int winner = ( leader + TrickWinner( trick, CardIdSuit( trick[0] ), m_state.GetTrumph() ) ) % N_SEATS;
+      return Engine::TeamOf( winner ) == 0 ? total : 0;
+    }
+    // Tricks to look ahead
+    depth = m_state.GetTricksLeft();
+    if( m_horizon && depth > m_horizon - m_state.GetTrickCount() ) {
+      depth = m_horizon - m_state.GetTrickCount();
+      if( depth <= 0 )
+        return Estimate( total );
+    }
+    // Cheaper than a table lookup, and keeps the table for larger ones
+    if( depth == 2 && m_state.GetTricksLeft() == 2 )
+      return SolveTwo();
+    // Tables are only used between tricks, where the outcome does not
+    // depend on how the position was reached. Entries from a shallower
+    // search only help ordering.
+    usetable = true;
+    canonical.Set( m_state.GetHands(), m_state.GetTrumph(), m_state.GetLeader() );
+    hash = canonical.GetHash();
+    if( m_table->Probe( hash, &entry, m_stats ) && entry.depth >= depth ) {
+      if( entry.lower >= beta || entry.lower == entry.upper )
+        return entry.lower;
+      if( entry.upper <= alpha )
+        return entry.upper;
+      if( entry.lower > alpha )
+        alpha = entry.lower;
+      if( entry.upper < beta )
+        beta = entry.upper;
+    }
+    else if( m_endgame && m_state.GetTricksLeft() <= m_endgame->GetMaxTricks() &&
+             m_state.GetTricksLeft() >= ENDGAME_MIN_TRICKS && m_endgame->Lookup( hash, &value ) ) {
+      // Solved offline, keep it at hand for the next time
+      m_endgamehits++;
+      entry.lower = entry.upper = value;
+      entry.depth = m_state.GetTricksLeft();
+      entry.move = NO_CARD;
+      m_table->Store( hash, entry, m_stats );
+      return value;
+    }
+    else {
+      entry.lower = 0;
+      entry.upper = NO_VALUE;
+    }
+    // The move stored is a canonical card too
+    for( CardSet hand = m_state.GetHand( m_state.GetTurn() ); entry.move != NO_CARD && !hand.IsEmpty(); ) {
+      cardid_t card = hand.PopFirst();
+      if( canonical.GetCard( card ) == entry.move )
+        first = card;
+    }
+  }
+  cardid_t moves[MAX_CARDS];
+  unsigned char runs[MAX_CARDS];
+  int n = OrderMoves( moves, first, runs );
+  bool maximize = Engine::TeamOf( m_state.GetTurn() ) == 0;
+  int best = maximize ? -1 : NO_VALUE;
+  cardid_t bestmove = moves[0];
+  // First card searched of each run of touching cards, and its value
+  cardid_t runcard[MAX_CARDS];
+  int runvalue[MAX_CARDS];
+  for( int i = 0; i < n; i++ )
+    runcard[i] = NO_CARD;
+  int a = alpha, b = beta;
+  for( int i = 0; i < n && a < b; i++ ) {
+    int run = runs[i];
+    if( runcard[run] != NO_CARD ) {
+      // Its value is within the difference of their points of the one
+      // searched, skip it if that cannot change the result
+      int diff = CardIdValue( moves[i] ) - CardIdValue( runcard[run] );
+      int bound = runvalue[run] + ( diff < 0 ? -diff : diff ) * ( maximize ? 1 : -1 );
+      if( maximize ? bound <= a : bound >= b ) {
+        if( maximize ? bound > best : bound < best )
+          best = bound;
+        continue;
+      }
+    }
+    int gain = Play( moves[i] );
+    int v = gain + Search( a - gain, b - gain );
+    m_state.Undo( moves[i] );
+    if( runcard[run] == NO_CARD ) {
+      runcard[run] = moves[i];
+      runvalue[run] = v;
+    }
+    if( maximize ? v > best : v < best ) {
+      best = v;
+      bestmove = moves[i];
+    }
+    if( maximize ) {
+      if( best > a )
+        a = best;
+    }
+    else if( best < b )
+      b = best;
+  }
+  if( usetable && !m_aborted ) {
+    // Failed low, the value is at most this. No move stood out, so the
+    // one from an earlier search, if any, stays the first to try.
+    if( best <= alpha ) {
+      entry.upper = best;
+      if( entry.move == NO_CARD )
+        entry.move = canonical.GetCard( bestmove );
+    }
+    else {
+      if( best >= beta )
+        entry.lower = best;  // Failed high, the value is at least this
+      else
+        entry.lower = entry.upper = best;
+      entry.move = canonical.GetCard( bestmove );
+    }
+    entry.depth = depth;
+    m_table->Store( hash, entry, m_stats );
+  }
+  return best;
+}
+
+// Guess of team 0's share of the points left, when the horizon stops
+// the search: the more trumphs a team holds, the more it should get
+int Solver::Estimate( int total ) const
+{
+  CardSet trumphs = m_state.GetInPlay().InSuit( m_state.GetTrumph() );
+  int own = ( trumphs & ( m_state.GetHand( 0 ) | m_state.GetHand( 2 ) ) ).Count();
+  return total * ( own + 1 ) / ( trumphs.Count() + 2 );
+}
+
+// Exact value between tricks with two left: every play of the first
+// one, the last plays itself
+int Solver::SolveTwo() const
+{
+  cardsuit_t trumph = m_state.GetTrumph();
+  int leader = m_state.GetLeader();
+  // By seat after the leader, the even ones are the leader's team
+  CardSet hands[N_SEATS];
+  for( int i = 0; i < N_SEATS; i++ )
+    hands[i] = m_state.GetHand( ( leader + i ) % N_SEATS );
+  int best0 = -1;
+  for( CardSet moves0 = hands[0]; !moves0.IsEmpty(); ) {
+    cardid_t trick[N_SEATS];
+    trick[0] = moves0.PopFirst();
+    cardsuit_t lead = CardIdSuit( trick[0] );
+    CardSet legal[N_SEATS];
+    for( int i = 1; i < N_SEATS; i++ )
+      legal[i] = hands[i].HasSuit( lead ) ? hands[i].InSuit( lead ) : hands[i];
+    int best1 = NO_VALUE;
+    for( CardSet moves1 = legal[1]; !moves1.IsEmpty() && best1 > best0; ) {
+      trick[1] = moves1.PopFirst();
+      int best2 = -1;
+      for( CardSet moves2 = legal[2]; !moves2.IsEmpty(); ) {
+        trick[2] = moves2.PopFirst();
+        int best3 = NO_VALUE;
+        for( CardSet moves3 = legal[3]; !moves3.IsEmpty() && best3 > best2; ) {
+          trick[3] = moves3.PopFirst();
+          int winner = TrickWinner( trick, lead, trumph );
+          int points = 0;
+          for( int i = 0; i < N_SEATS; i++ )
+            points += CardIdValue( trick[i] );
+          // The winner leads what is left
+          cardid_t last[N_SEATS];
+          for( int i = 0; i < N_SEATS; i++ ) {
+            int seat = ( winner + i ) % N_SEATS;
+            last[i] = ( hands[seat] - CardSet::Single( trick[seat] ) ).First();
+          }
+          int lastwinner = ( winner + TrickWinner( last, CardIdSuit( last[0] ), trumph ) ) % N_SEATS;
+          int value = winner % 2 == 0 ? points : 0;
+          if( lastwinner % 2 == 0 )
+            for( int i = 0; i < N_SEATS; i++ )
+              value += CardIdValue( last[i] );
+          if( value < best3 )
+            best3 = value;
+        }
+        if( best3 > best2 )
+          best2 = best3;
+      }
+      if( best2 < best1 )
+        best1 = best2;
+    }
+    if( best1 > best0 )
+      best0 = best1;
+  }
+  return Engine::TeamOf( leader ) == 0 ? best0 : m_state.GetInPlay().Points() - best0;
+}
+
+// Whether the seat has no cards of the suit but can trump it
+bool Solver::Ruffs( int seat, cardsuit_t suit ) const
+{
+  CardSet hand = m_state.GetHand( seat );
+  return !hand.HasSuit( suit ) && hand.HasSuit( m_state.GetTrumph() );
+}
+
+// Whether the seat can take a trick of the given lead from the card
+bool Solver::Beats( int seat, cardid_t card, cardsuit_t lead ) const
+{
+  CardSet hand = m_state.GetHand( seat );
+  cardsuit_t trumph = m_state.GetTrumph();
+  cardsuit_t suit = CardIdSuit( card );
+  bool higher = !( hand.InSuit( suit ) - CardSet( ( (cardmask_t)2 << card ) - 1 ) ).IsEmpty();
+  if( suit == trumph )
+    return higher && ( lead == trumph || !hand.HasSuit( lead ) );
+  return hand.HasSuit( lead ) ? higher : hand.HasSuit( trumph );
+}
+
+// Legal moves of the seat to move, the most promising first, or the
+// given one first when it is among them (e.g. the best from the table).
+// Cards touching in a suit (nothing in the other hands or the trick
+// between them) win and lose the same tricks: of those worth the same
+// only the lowest is kept, the others get the same run number, if asked.
+int Solver::OrderMoves( cardid_t* moves, cardid_t first, unsigned char* runs )
+{
+  CardSet legal = m_state.LegalMoves();
+  int scores[MAX_CARDS];
+  unsigned char cardruns[MAX_CARDS];
+  int n = 0;
+  int run = -1;
+  int turn = m_state.GetTurn();
+  cardsuit_t trumph = m_state.GetTrumph();
+  const cardid_t* trick = m_state.GetTrick();
+  int ntrick = m_state.GetPlayedCount();
+  // Card winning the trick so far, and whether it is our partner's
+  int winner = ntrick ? TrickWinnerSoFar( trick, ntrick, trumph ) : 0;
+  cardid_t winning = trick[winner];
+  bool partner = ntrick && ( ntrick - winner ) % 2 == 0;
+  cardsuit_t lead = ntrick ? CardIdSuit( trick[0] ) : (cardsuit_t)0;
+  const unsigned char* key = trick_keys.key[trumph][lead];
+  CardSet others = m_state.GetInPlay() - m_state.GetHand( turn );
+  // Cards telling apart two cards of the hand: the other hands' and the trick's
+  CardSet separators = others;
+  for( int i = 0; i < ntrick; i++ )
+    separators.Add( trick[i] );
+  cardid_t last = NO_CARD;
+  while( !legal.IsEmpty() ) {
+    cardid_t card = legal.PopFirst();
+    cardsuit_t suit = CardIdSuit( card );
+    int rank = CardIdRank( card );
+    int value = CardIdValue( card );
+    // Legal cards come in ascending order, so the one just before of the
+    // same suit, with no separator between, touches it
+    bool touching = last != NO_CARD && CardIdSuit( last ) == suit &&
+      ( separators.GetMask() & ( ( (cardmask_t)1 << card ) - ( (cardmask_t)2 << last ) ) ) == 0;
+    bool equivalent = touching && CardIdValue( last ) == value;
+    last = card;
+    if( equivalent )
+      continue;
+    if( !touching )
+      run++;
+    int score;
+    if( card == first )
+      score = 128;
+    else if( !ntrick ) {
+      // Lead low cards of a suit an opponent can ruff, then to one the
+      // partner can, then the best cards of a suit, then low cards to a
+      // partner holding the best one, or else low cards
+      CardSet higher = others.InSuit( suit ) - CardSet( ( (cardmask_t)2 << card ) - 1 );
+      if( suit != trumph && ( Ruffs( ( turn + 1 ) % N_SEATS, suit ) || Ruffs( ( turn + 3 ) % N_SEATS, suit ) ) )
+        score = 16 - rank;
+      else if( suit != trumph && Ruffs( ( turn + 2 ) % N_SEATS, suit ) )
+        score = 56 - value - rank;
+      else if( higher.IsEmpty() )
+        score = 64 + value;
+      else if( m_state.GetHand( ( turn + 2 ) % N_SEATS ).Contains( higher.Last() ) )
+        score = 48 - rank;
+      else
+        score = 32 - rank;
+    }
+    else {
+      bool wins = key[card] > key[winning];
+      cardid_t top = wins ? card : winning;
+      // Can an opponent still to play beat the card taking the trick
+      bool beaten = false;
+      for( int i = ntrick + 1; i < N_SEATS && !beaten; i += 2 )
+        beaten = Beats( ( turn + i - ntrick ) % N_SEATS, top, lead );
+      if( ( wins || partner ) && !beaten )
+        score = wins && !partner ? 80 - rank : 40 + value;  // Ours, win cheaply or give points
+      else if( wins && !partner )
+        score = 56 - rank;  // Make them spend a higher card
+      else
+        score = 16 - value - rank;  // Throw away the lowest card
+    }
+    // Insertion sort, best score first
+    int i = n++;
+    for( ; i > 0 && scores[i - 1] < score; i-- ) {
+      scores[i] = scores[i - 1];
+      moves[i] = moves[i - 1];
+      cardruns[i] = cardruns[i - 1];
+    }
+    scores[i] = score;
+    moves[i] = card;
+    cardruns[i] = run;
+  }
+  if( runs )
+    for( int i = 0; i < n; i++ )
+      runs[i] = cardruns[i];
+  return n;
+}
+
+// Returns the points team 0 gets if the card completes a trick
+int Solver::Play( cardid_t card )
+{
+  int points = m_state.GetPoints( 0 );
+  m_state.Apply( card );
+  return m_state.GetPoints( 0 ) - points;
+}
@@ -0,0 +1,135 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _SOLVER_HPP_
+#define _SOLVER_HPP_ 1
+
+// Forward declarations
+class SearchLimit;
+class Solver;
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include "gamestate.hpp"
+#include "transtable.hpp"
+#include "endgame.hpp"
+
+#define LIMIT_CHECK_NODES 1024  // Nodes searched between looks at the limit
+
+// Time and node budget of a search, shared by all the solvers working on
+// it (e.g. on several threads). Once over, it stays over until started
+// again.
+class SearchLimit
+{
+public:
+  SearchLimit(): m_budget( 0 ), m_maxnodes( 0 ), m_nodes( 0 ), m_over( false ) {}
+  // Budget in ms from now, 0 for no limit on the time or on the nodes
+  void Start( int budget, unsigned long maxnodes );
+  bool IsSet() const { return m_budget || m_maxnodes; }
+  // Adds the nodes searched since the last call, true once over the budget
+  bool Check( unsigned long nodes );
+  // Makes it over now, from any thread
+  void Stop() { m_over.store( true, std::memory_order_relaxed ); }
+  bool IsOver() const { return m_over.load( std::memory_order_relaxed ); }
+  unsigned long GetNodes() const { return m_nodes.load( std::memory_order_relaxed ); }
+private:
+  int m_budget;
+  unsigned long m_maxnodes;
+  std::chrono::steady_clock::time_point m_deadline;
+  std::atomic<unsigned long> m_nodes;
+  std::atomic<bool> m_over;
+};
+
+// Double dummy solver: finds the exact outcome of the rest of a round
+// when every hand is known, assuming perfect play from everyone.
+// Values are the points team 0 (seats 0 and 2) gets from the cards
+// still in play, including those of the current trick.
+// With a horizon it becomes a depth limited search, for when there is no
+// time to look until the end.
+// Cards made equivalent by those already out (zero point cards of a suit
+// with nothing left between them) are searched only once, and positions
+// are stored by their CanonicalPosition. Touching cards worth different
+// points are within that difference of each other, so the second one is
+// skipped when that cannot change the result.
+// With two tricks left every play is tried, without the table.
+// Cost grows about tenfold per trick left: milliseconds at 6 tricks,
+// about half a second at 8, and 15 seconds on average (up to 45) for a
+// whole 10-trick deal (see solverbench). It is meant for positions from mid-round on,
+// or with a horizon.
+// Not thread safe, every thread needs its own solver, but solvers in
+// different threads can share a transposition table.
+class Solver
+{
+public:
+  // With a transposition table of its own, of 2^tablebits entries
+  Solver( int tablebits = 20 );
+  // With a table that may be shared with other solvers
+  Solver( TransTable& table );
+  ~Solver();
+  // Trick holds the cards already played by the leader and the seats
+  // after it (an incomplete trick), hands must have the right number of
+  // cards each
+  void SetPosition( const CardSet* hands, cardsuit_t trumph, int leader,
+                    const cardid_t* trick, int ntrick );
+  void SetPosition( const Engine& engine );
+  void SetPosition( const GameState& state );
+  int GetTurn() const { return m_state.GetTurn(); }
+  // Look only this many tricks ahead (counting the current one), and
+  // guess the rest: values become estimates. 0 searches to the end.
+  void SetHorizon( int tricks ) { m_horizon = tricks; }
+  int GetHorizon() const { return m_horizon; }
+  // Solved endgames to look up (endgame_table by default), NULL for none
+  void SetEndgameTable( const EndgameTable* table ) { m_endgame = table; }
+  // Gives up searching once the limit is over, NULL for no limit. Values
+  // found after that mean nothing, IsAborted() tells when it happened
+  // (until the next SetPosition).
+  void SetLimit( SearchLimit* limit ) { m_limit = limit; }
+  bool IsAborted() const { return m_aborted; }
+  int Solve();
+  // Value after the seat to move plays the given (legal) card
+  int SolveMove( cardid_t card );
+  // Best card for the seat to move, and its value
+  cardid_t BestMove( int* value = NULL );
+  unsigned long GetNodes() const { return m_nodes; }
+  void ResetNodes() { m_nodes = 0; }
+  unsigned long GetEndgameHits() const { return m_endgamehits; }
+  const TableStats& GetTableStats() const { return m_stats; }
+  TransTable& GetTable() { return *m_table; }
+private:
+  int Search( int alpha, int beta );
+  int OrderMoves( cardid_t* moves, cardid_t first = NO_CARD, unsigned char* runs = NULL );
+  int Play( cardid_t card );
+  int Estimate( int total ) const;
+  int SolveTwo() const;
+  bool Ruffs( int seat, cardsuit_t suit ) const;
+  bool Beats( int seat, cardid_t card, cardsuit_t lead ) const;
+  GameState m_state;
+  int m_horizon;
+  unsigned long m_nodes;
+  TransTable* m_table;
+  bool m_owntable;
+  TableStats m_stats;
+  const EndgameTable* m_endgame;
+  unsigned long m_endgamehits;
+  SearchLimit* m_limit;
+  bool m_aborted;
+};
+
+#endif  // _SOLVER_HPP_
@@ -0,0 +1,76 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+// Benchmark of the double dummy solver over a fixed corpus of deals.
+// Positions are reached by random play, then solved with a fresh solver.
+// Usage: solverbench [max tricks left (default 8)] [deals per level (default 20)]
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include "solver.hpp"
+
+int main( int argc, char** argv )
+{
+  int maxtricks = argc > 1 ? atoi( argv[1] ) : 8;
+  int ndeals = argc > 2 ? atoi( argv[2] ) : 20;
+  if( maxtricks < 1 || maxtricks > MAX_CARDS || ndeals < 1 ) {
+    fprintf( stderr, "Usage: solverbench [max tricks left] [deals per level]\n" );
+    return 1;
+  }
+  printf( "Tricks left      Nodes    Avg ms    Max ms  Hits %%  Checksum\n" );
+  for( int left = 4; left <= maxtricks; left++ ) {
+    unsigned long nodes = 0;
+    double total = 0, worst = 0;
+    long checksum = 0;
+    TableStats stats;
+    for( int deal = 0; deal < ndeals; deal++ ) {
+      Engine engine;
+      engine.Seed( deal );
+      engine.NewGame( deal % N_SEATS );
+      engine.NewRound();
+      Rng& rng = engine.GetRng();
+      while( engine.GetTricksLeft() > left ) {
+        for( int i = 0; i < N_SEATS; i++ ) {
+          int seat = engine.GetTurn();
+          CardSet moves = Engine::LegalMoves( engine.GetHand( seat ), engine.GetLead() );
+          for( int skip = rng.Below( moves.Count() ); skip > 0; skip-- )
+            moves.PopFirst();
+          engine.PlayMove( seat, moves.First() );
+        }
+        engine.EndTrick();
+      }
+      // Same conditions for every position
+      Solver* fresh = new Solver( 22 );
+      fresh->SetPosition( engine );
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      checksum += fresh->Solve();
+      double ms = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+      nodes += fresh->GetNodes();
+      stats.Add( fresh->GetTableStats() );
+      total += ms;
+      if( ms > worst )
+        worst = ms;
+      delete fresh;
+    }
+    printf( "%11d %10lu %9.2f %9.2f %7.1f %9ld\n", left, nodes / ndeals, total / ndeals,
+            worst, stats.probes ? 100.0 * stats.hits / stats.probes : 0.0, checksum );
+  }
+  return 0;
+}
@@ -0,0 +1,235 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+// sueca-sim: plays bot against bot matches on all cores, without a GUI
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <vector>
+#include "bot.hpp"
+#include "endgame.hpp"
+#include "leadbook.hpp"
+#include "decisioncache.hpp"
+#include "rng.hpp"
+#include "workpool.hpp"
+
+// Results of the matches run by one thread, summed up at the end.
+// Threads never write to each other's results, so no locking is needed.
+struct alignas( 64 ) SimResults
+{
+  unsigned long matches[2];  // Won by each team
+  unsigned long rounds;
+  unsigned long tied;
+  unsigned long points[2];
+  unsigned long capotes[2];
+};
+
+class SimJob: public PoolJob
+{
+public:
+  SimJob( const char** botnames, int victories, uint64_t seed, int threads,
+          int budget, unsigned long nodes ):
+    m_botnames( botnames ), m_victories( victories ), m_seed( seed ),
+    m_budget( budget ), m_nodes( nodes ),
+    m_results( threads ) { memset( &m_results[0], 0, threads * sizeof( SimResults ) ); }
+  void Run( long item, int worker );
+  SimResults Total() const;
+private:
+  const char** m_botnames;
+  int m_victories;
+  uint64_t m_seed;
+  int m_budget;  // Per move, for the bots that search
+  unsigned long m_nodes;
+  std::vector<SimResults> m_results;
+};
+
+void SimJob::Run( long item, int worker )
+{
+  SimResults& results = m_results[worker];
+  // Every match has its own seed, so results don't depend on the
+  // number of threads or on which thread ran it
+  Engine engine;
+  uint64_t seed = m_seed ^ ( item * 0x9e3779b97f4a7c15ULL );
+  engine.Seed( seed );
+  Bot* bots[N_SEATS];
+  for( int seat = 0; seat < N_SEATS; seat++ ) {
+    bots[seat] = Bot::Create( m_botnames[Engine::TeamOf( seat )] );
+    bots[seat]->Seed( seed ^ ( ( seat + 1 ) * 0xbf58476d1ce4e5b9ULL ) );
+    bots[seat]->SetBudget( m_budget, m_nodes );
+  }
+  BotTable table( engine, bots );
+  table.NewGame( engine.GetRng().Below( N_SEATS ) );
+  while( engine.GetWon( 0 ) < m_victories && engine.GetWon( 1 ) < m_victories ) {
+    int winteam;
+    table.PlayRound( &winteam );
+    results.rounds++;
+    if( winteam < 0 )
+      results.tied++;
+    for( int team = 0; team < 2; team++ ) {
+      results.points[team] += engine.GetRoundPoints( team );
+      if( engine.GetCaptured( team ).Count() == N_CARDS )
+        results.capotes[team]++;
+    }
+  }
+  results.matches[engine.GetWon( 0 ) < m_victories ? 1 : 0]++;
+  for( int seat = 0; seat < N_SEATS; seat++ )
+    delete bots[seat];
+}
+
+SimResults SimJob::Total() const
+{
+  SimResults total;
+  memset( &total, 0, sizeof( total ) );
+  for( size_t i = 0; i < m_results.size(); i++ ) {
+    const SimResults& results = m_results[i];
+    total.rounds += results.rounds;
+    total.tied += results.tied;
+    for( int team = 0; team < 2; team++ ) {
+      total.matches[team] += results.matches[team];
+      total.points[team] += results.points[team];
+      total.capotes[team] += results.capotes[team];
+    }
+  }
+  return total;
+}
+
+static void Usage()
+{
+  fprintf( stderr,
+           "Usage: sueca-sim [options] [bot1 [bot2]]\n"
+           "Plays matches between bot1 (seats 1 and 3) and bot2 (seats 2 and 4).\n"
+           "Options:\n"
+           "  -n MATCHES    number of matches to play (default 10000)\n"
+           "  -v VICTORIES  victories needed to win a match (default 4)\n"
+           "  -t THREADS    worker threads (default: one per core)\n"
+           "  -s SEED       random seed, to replay the same deals (default: random)\n"
+           "  -e FILE       endgame table for the solvers (default: none)\n"
+           "  -b FILE       opening lead book for the pimc bot (default: none)\n"
+           "  -m MS         time per move for the pimc and ismcts bots (default: no limit)\n"
+           "  -l NODES      search nodes per move for the pimc and ismcts bots (default: no limit)\n"
+           "  -c BITS       decision cache of 2^BITS entries shared by the pimc bots (default: none)\n"
+           "  -k FILE       decision cache kept in a file between runs (with -c)\n"
+           "Bots:" );
+  for( int i = 0; Bot::names[i]; i++ )
+    fprintf( stderr, " %s", Bot::names[i] );
+  fprintf( stderr, " (default: smart dumb)\n" );
+}
+
+int main( int argc, char** argv )
+{
+  long matches = 10000;
+  int victories = 4;
+  int threads = 0;
+  uint64_t seed = Rng::RandomSeed();
+  int budget = 0;
+  unsigned long nodes = 0;
+  int cachebits = 0;
+  const char* cachefile = NULL;
+  const char* botnames[2] = { "smart", "dumb" };
+  int nbots = 0;
+  for( int i = 1; i < argc; i++ ) {
+    if( argv[i][0] == '-' && argv[i][1] && !argv[i][2] && i + 1 < argc ) {
+      const char* value = argv[++i];
+      switch( argv[i - 1][1] ) {
+      case 'n':
+        matches = atol( value );
+        continue;
+      case 'v':
+        victories = atoi( value );
+        continue;
+      case 't':
+        threads = atoi( value );
+        continue;
+      case 's':
+        seed = strtoull( value, NULL, 0 );
+        continue;
+      case 'm':
+        budget = atoi( value );
+        continue;
+      case 'l':
+        nodes = strtoul( value, NULL, 0 );
+        continue;
+      case 'c':
+        cachebits = atoi( value );
+        continue;
+      case 'k':
+        cachefile = value;
+        continue;
+      case 'e':
+        if( endgame_table.Open( value ) )
+          continue;
+        fprintf( stderr, "Could not open the endgame table %s\n", value );
+        return 1;
+      case 'b':
+        if( lead_book.Open( value ) )
+          continue;
+        fprintf( stderr, "Could not open the lead book %s\n", value );
+        return 1;
+      }
+    }
+    else if( argv[i][0] != '-' && nbots < 2 ) {
+      Bot* bot = Bot::Create( argv[i] );
+      if( bot ) {
+        delete bot;
+        botnames[nbots++] = argv[i];
+        continue;
+      }
+    }
+    Usage();
+    return 1;
+  }
+  if( matches <= 0 || victories <= 0 || budget < 0 ) {
+    Usage();
+    return 1;
+  }
+
+  decision_cache.Resize( cachebits );
+  if( cachefile && cachebits )
+    decision_cache.Load( cachefile );
+
+  WorkPool pool( threads );
+  SimJob job( botnames, victories, seed, pool.GetThreads(), budget, nodes );
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  pool.Run( job, matches );
+  double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+  SimResults total = job.Total();
+  printf( "%ld matches to %d victories, %d threads, seed %llu\n", matches,
+          victories, pool.GetThreads(), (unsigned long long)seed );
+  for( int team = 0; team < 2; team++ )
+    printf( "Team %d (%s): %5.1f%% matches won, %5.1f average round points, %lu capotes\n",
+            team + 1, botnames[team], 100.0 * total.matches[team] / matches,
+            (double)total.points[team] / total.rounds, total.capotes[team] );
+  printf( "%lu rounds (%lu tied) in %.2f s, %.0f deals/s\n", total.rounds,
+          total.tied, seconds, total.rounds / seconds );
+  if( decision_cache.IsEnabled() ) {
+    DecisionStats stats = decision_cache.GetStats();
+    printf( "Decision cache: %llu lookups, %.1f%% hits, %llu evictions, %lu of %lu entries (%lu KB)\n",
+            (unsigned long long)stats.lookups, stats.lookups ? 100.0 * stats.hits / stats.lookups : 0.0,
+            (unsigned long long)stats.evictions, (unsigned long)stats.entries,
+            (unsigned long)stats.slots, (unsigned long)( stats.bytes >> 10 ) );
+    if( cachefile && !decision_cache.Save( cachefile ) ) {
+      fprintf( stderr, "Could not write the decision cache %s\n", cachefile );
+      return 1;
+    }
+  }
+  return 0;
+}
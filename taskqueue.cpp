@@ -0,0 +1,71 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include "taskqueue.hpp"
+
+// Task queue implementation
+TaskQueue::TaskQueue( int threads ):
+  m_stop( false )
+{
+  if( threads <= 0 )
+    threads = std::thread::hardware_concurrency();
+  if( threads <= 0 )
+    threads = 1;
+  for( int i = 0; i < threads; i++ )
+    m_threads.push_back( std::thread( &TaskQueue::Worker, this ) );
+}
+
+TaskQueue::~TaskQueue()
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_stop = true;
+  }
+  m_wakeup.notify_all();
+  for( size_t i = 0; i < m_threads.size(); i++ )
+    m_threads[i].join();
+}
+
+void TaskQueue::Post( QueueTask* task )
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_tasks.push_back( task );
+  }
+  m_wakeup.notify_one();
+}
+
+void TaskQueue::Worker()
+{
+  for( ;; ) {
+    QueueTask* task;
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      // Stopping only once every task posted has run
+      while( m_tasks.empty() && !m_stop )
+        m_wakeup.wait( lock );
+      if( m_tasks.empty() )
+        return;
+      task = m_tasks.front();
+      m_tasks.pop_front();
+    }
+    task->Run();
+    delete task;
+  }
+}
@@ -0,0 +1,64 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _TASKQUEUE_HPP_
+#define _TASKQUEUE_HPP_ 1
+
+// Forward declarations
+class QueueTask;
+class TaskQueue;
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work to run in the background by a TaskQueue
+class QueueTask
+{
+public:
+  virtual ~QueueTask() {}
+  virtual void Run() = 0;
+};
+
+// Runs tasks on background threads, in the order they were posted, for
+// work that must not hold up whoever posts it (e.g. the GUI thread
+// waiting for a bot to think). Unlike a WorkPool, Post() returns at
+// once: the task must tell about its results by itself when done.
+class TaskQueue
+{
+public:
+  // 0 threads means one per hardware thread
+  TaskQueue( int threads = 1 );
+  // Waits for the tasks already posted
+  ~TaskQueue();
+  int GetThreads() const { return m_threads.size(); }
+  // The queue owns the task, and deletes it after running it
+  void Post( QueueTask* task );
+private:
+  void Worker();
+  std::mutex m_mutex;
+  std::condition_variable m_wakeup;
+  std::deque<QueueTask*> m_tasks;
+  std::vector<std::thread> m_threads;
+  bool m_stop;
+};
+
+#endif  // _TASKQUEUE_HPP_
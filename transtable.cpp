@@ -0,0 +1,139 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include "transtable.hpp"
+
+// Set in the data of every used slot, so empty slots never match
+#define SLOT_USED ( (uint64_t)1 << 63 )
+// Buckets looked at by Usage()
+#define USAGE_SAMPLE 1024
+
+void TableStats::Add( const TableStats& other )
+{
+  probes += other.probes;
+  hits += other.hits;
+  stores += other.stores;
+  replaced += other.replaced;
+}
+
+// Transposition table implementation
+TransTable::TransTable( int bits )
+{
+  int bucketbits = bits > 2 ? bits - 2 : 0;  // 4 slots per bucket
+  m_mask = ( (uint64_t)1 << bucketbits ) - 1;
+  m_buckets = new TableBucket[m_mask + 1];
+  Clear();
+}
+
+TransTable::~TransTable()
+{
+  delete[] m_buckets;
+}
+
+void TransTable::Clear()
+{
+  for( uint64_t i = 0; i <= m_mask; i++ )
+    for( int j = 0; j < TABLE_BUCKET_SLOTS; j++ ) {
+      m_buckets[i].slots[j].check.store( 0, std::memory_order_relaxed );
+      m_buckets[i].slots[j].data.store( 0, std::memory_order_relaxed );
+    }
+}
+
+uint64_t TransTable::Pack( const TableEntry& entry )
+{
+  return SLOT_USED | (uint16_t)entry.lower | (uint64_t)(uint16_t)entry.upper << 16 |
+    (uint64_t)entry.depth << 32 | (uint64_t)entry.move << 40;
+}
+
+TableEntry TransTable::Unpack( uint64_t data )
+{
+  TableEntry entry;
+  entry.lower = (short)( data & 0xffff );
+  entry.upper = (short)( ( data >> 16 ) & 0xffff );
+  entry.depth = (unsigned char)( data >> 32 );
+  entry.move = (cardid_t)( data >> 40 );
+  return entry;
+}
+
+bool TransTable::Probe( uint64_t key, TableEntry* entry, TableStats& stats ) const
+{
+  stats.probes++;
+  const TableBucket& bucket = m_buckets[key & m_mask];
+  for( int i = 0; i < TABLE_BUCKET_SLOTS; i++ ) {
+    uint64_t data = bucket.slots[i].data.load( std::memory_order_relaxed );
+    uint64_t check = bucket.slots[i].check.load( std::memory_order_relaxed );
+    if( ( data & SLOT_USED ) && ( check ^ data ) == key ) {
+      *entry = Unpack( data );
+      stats.hits++;
+      return true;
+    }
+  }
+  return false;
+}
+
+void TransTable::Store( uint64_t key, const TableEntry& entry, TableStats& stats )
+{
+  stats.stores++;
+  TableBucket& bucket = m_buckets[key & m_mask];
+  // The same position, else an empty slot, else the least useful entry
+  int victim = 0;
+  int victimworth = 0x7fffffff;
+  for( int i = 0; i < TABLE_BUCKET_SLOTS; i++ ) {
+    uint64_t data = bucket.slots[i].data.load( std::memory_order_relaxed );
+    uint64_t check = bucket.slots[i].check.load( std::memory_order_relaxed );
+    if( !( data & SLOT_USED ) || ( check ^ data ) == key ) {
+      victim = i;
+      victimworth = -1;
+      break;
+    }
+    TableEntry other = Unpack( data );
+    int worth = other.depth * 2 + ( other.lower == other.upper );
+    if( worth < victimworth ) {
+      victim = i;
+      victimworth = worth;
+    }
+  }
+  if( victimworth >= 0 )
+    stats.replaced++;
+  uint64_t data = Pack( entry );
+  bucket.slots[victim].check.store( key ^ data, std::memory_order_relaxed );
+  bucket.slots[victim].data.store( data, std::memory_order_relaxed );
+}
+
+bool TransTable::GetSlot( size_t i, uint64_t* key, TableEntry* entry ) const
+{
+  const TableSlot& slot = m_buckets[i / TABLE_BUCKET_SLOTS].slots[i % TABLE_BUCKET_SLOTS];
+  uint64_t data = slot.data.load( std::memory_order_relaxed );
+  if( !( data & SLOT_USED ) )
+    return false;
+  *key = slot.check.load( std::memory_order_relaxed ) ^ data;
+  *entry = Unpack( data );
+  return true;
+}
+
+int TransTable::Usage() const
+{
+  uint64_t n = m_mask + 1 < USAGE_SAMPLE ? m_mask + 1 : USAGE_SAMPLE;
+  int used = 0;
+  for( uint64_t i = 0; i < n; i++ )
+    for( int j = 0; j < TABLE_BUCKET_SLOTS; j++ )
+      if( m_buckets[i].slots[j].data.load( std::memory_order_relaxed ) & SLOT_USED )
+        used++;
+  return (int)( used * 1000 / ( n * TABLE_BUCKET_SLOTS ) );
+}
@@ -0,0 +1,95 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _TRANSTABLE_HPP_
+#define _TRANSTABLE_HPP_ 1
+
+// Forward declarations
+struct TableEntry;
+struct TableStats;
+class TransTable;
+
+#include <stdint.h>
+#include <cstddef>  // For size_t
+#include <atomic>
+#include "corecards.hpp"
+
+#define TABLE_BUCKET_SLOTS 4
+
+// What is known of a searched position
+struct TableEntry
+{
+  short lower;     // Bounds of its value
+  short upper;
+  unsigned char depth;  // How much search it took, e.g. tricks left
+  cardid_t move;   // Best move found, or NO_CARD
+};
+
+// Counters of table use, kept by each user of the table (e.g. one per
+// thread) so that sharing a table does not mean sharing counters
+struct TableStats
+{
+  unsigned long probes;
+  unsigned long hits;
+  unsigned long stores;
+  unsigned long replaced;  // Stores over a different position
+  TableStats(): probes( 0 ), hits( 0 ), stores( 0 ), replaced( 0 ) {}
+  void Add( const TableStats& other );
+};
+
+// Transposition table, keyed by Zobrist hashes.
+// Slots are grouped in buckets of one cache line, a position can be in
+// any slot of its bucket. When the bucket is full, the entry with the
+// least depth is replaced, entries with only a bound going first.
+// Can be shared between threads without locks: every slot keeps its key
+// xored with its data, so a slot being written by another thread just
+// looks like a different position.
+class TransTable
+{
+public:
+  // 2^bits entries, at least one bucket
+  TransTable( int bits = 20 );
+  ~TransTable();
+  bool Probe( uint64_t key, TableEntry* entry, TableStats& stats ) const;
+  void Store( uint64_t key, const TableEntry& entry, TableStats& stats );
+  // Not thread safe
+  void Clear();
+  // Used slots per thousand, from a sample of the table
+  int Usage() const;
+  size_t GetSize() const { return ( m_mask + 1 ) * sizeof( TableBucket ); }
+  // Walk over the slots (e.g. to save entries), false for an empty one
+  size_t GetSlots() const { return ( m_mask + 1 ) * TABLE_BUCKET_SLOTS; }
+  bool GetSlot( size_t i, uint64_t* key, TableEntry* entry ) const;
+private:
+  struct TableSlot
+  {
+    std::atomic<uint64_t> check;  // Key ^ data
+    std::atomic<uint64_t> data;
+  };
+  struct alignas( 64 ) TableBucket
+  {
+    TableSlot slots[TABLE_BUCKET_SLOTS];
+  };
+  static uint64_t Pack( const TableEntry& entry );
+  static TableEntry Unpack( uint64_t data );
+  TableBucket* m_buckets;
+  uint64_t m_mask;
+};
+
+#endif  // _TRANSTABLE_HPP_
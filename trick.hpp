@@ -0,0 +1,75 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _TRICK_HPP_
+#define _TRICK_HPP_ 1
+
+// Forward declarations
+struct TrickKeyTable;
+
+#include "corecards.hpp"
+
+// Strength of every card for each trumph and lead suit: trumphs beat
+// cards of the lead suit, which beat everything else (key 0)
+struct TrickKeyTable
+{
+  unsigned char key[N_SUITS][N_SUITS][N_CARDS];  // [trumph][lead][card]
+  constexpr TrickKeyTable(): key()
+  {
+    for( int trumph = 0; trumph < N_SUITS; trumph++ )
+      for( int lead = 0; lead < N_SUITS; lead++ )
+        for( int card = 0; card < N_CARDS; card++ ) {
+          int suit = card / N_RANKS;
+          int rank = card % N_RANKS;
+          key[trumph][lead][card] = suit == trumph ? 2 * N_RANKS + rank + 1 :
+            suit == lead ? N_RANKS + rank + 1 : 0;
+        }
+  }
+};
+
+extern const TrickKeyTable trick_keys;
+
+// Position (0 is the leader) of the winner of a complete trick.
+// Only off-suit cards share a key (0), and the lead card never has it,
+// so the highest key has a single owner.
+inline int TrickWinner( const cardid_t* cards, cardsuit_t lead, cardsuit_t trumph )
+{
+  const unsigned char* key = trick_keys.key[trumph][lead];
+  // Keep the position in the low bits so a single max finds the winner
+  unsigned int k0 = key[cards[0]] << 2;
+  unsigned int k1 = key[cards[1]] << 2 | 1;
+  unsigned int k2 = key[cards[2]] << 2 | 2;
+  unsigned int k3 = key[cards[3]] << 2 | 3;
+  unsigned int a = k0 > k1 ? k0 : k1;
+  unsigned int b = k2 > k3 ? k2 : k3;
+  return ( a > b ? a : b ) & 3;
+}
+
+// Position of the card winning an incomplete trick (at least one card)
+inline int TrickWinnerSoFar( const cardid_t* cards, int n, cardsuit_t trumph )
+{
+  const unsigned char* key = trick_keys.key[trumph][CardIdSuit( cards[0] )];
+  int winner = 0;
+  for( int i = 1; i < n; i++ )
+    if( key[cards[i]] > key[cards[winner]] )
+      winner = i;
+  return winner;
+}
+
+#endif  // _TRICK_HPP_
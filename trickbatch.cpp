@@ -0,0 +1,171 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include "trickbatch.hpp"
+#include "trick.hpp"
+
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define TRICK_BATCH_X86 1
+#include <immintrin.h>
+#endif
+
+// Reference kernel, one world at a time
+static void EvalScalar( const TrickBatch* batches, int n, cardsuit_t trumph,
+                        unsigned char* winners, unsigned char* points )
+{
+  for( int b = 0; b < n; b++ )
+    for( int w = 0; w < TRICK_BATCH; w++ ) {
+      cardid_t cards[N_TRICK_CARDS];
+      int value = 0;
+      for( int i = 0; i < N_TRICK_CARDS; i++ ) {
+        cards[i] = batches[b].cards[i][w];
+        value += CardIdValue( cards[i] );
+      }
+      winners[b * TRICK_BATCH + w] = TrickWinner( cards, CardIdSuit( cards[0] ), trumph );
+      points[b * TRICK_BATCH + w] = value;
+    }
+}
+
+#ifdef TRICK_BATCH_X86
+// Both vector kernels compute, for every byte (card id) of a row, the
+// suit from comparisons (no byte division), the rank as id - 10 * suit,
+// the TrickKeyTable key from the suit and rank, shifted left by 2 with
+// the position in the low bits so a max finds the winner, and the value
+// from a 16 byte table lookup on the rank.
+
+__attribute__(( target( "sse4.1" ) ))
+static void EvalSse4( const TrickBatch* batches, int n, cardsuit_t trumph,
+                      unsigned char* winners, unsigned char* points )
+{
+  const __m128i tens = _mm_setr_epi8( 0, 10, 20, 30, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 );
+  const __m128i values = _mm_setr_epi8( 0, 0, 0, 0, 0, 2, 3, 4, 10, 11, 0, 0, 0, 0, 0, 0 );
+  const __m128i nine = _mm_set1_epi8( 9 );
+  const __m128i nineteen = _mm_set1_epi8( 19 );
+  const __m128i twentynine = _mm_set1_epi8( 29 );
+  const __m128i trumphs = _mm_set1_epi8( trumph );
+  const __m128i trumphbase = _mm_set1_epi8( 2 * N_RANKS + 1 );
+  const __m128i leadbase = _mm_set1_epi8( N_RANKS + 1 );
+  const __m128i three = _mm_set1_epi8( 3 );
+  for( int b = 0; b < n; b++ ) {
+    __m128i best = _mm_setzero_si128();
+    __m128i sum = _mm_setzero_si128();
+    __m128i lead = _mm_setzero_si128();
+    for( int i = 0; i < N_TRICK_CARDS; i++ ) {
+      __m128i cards = _mm_load_si128( (const __m128i*)batches[b].cards[i] );
+      __m128i suit = _mm_sub_epi8( _mm_setzero_si128(),
+                                   _mm_add_epi8( _mm_add_epi8( _mm_cmpgt_epi8( cards, nine ),
+                                                               _mm_cmpgt_epi8( cards, nineteen ) ),
+                                                 _mm_cmpgt_epi8( cards, twentynine ) ) );
+      __m128i rank = _mm_sub_epi8( cards, _mm_shuffle_epi8( tens, suit ) );
+      if( i == 0 )
+        lead = suit;
+      __m128i istrumph = _mm_cmpeq_epi8( suit, trumphs );
+      __m128i islead = _mm_andnot_si128( istrumph, _mm_cmpeq_epi8( suit, lead ) );
+      __m128i key = _mm_or_si128( _mm_and_si128( istrumph, _mm_add_epi8( rank, trumphbase ) ),
+                                  _mm_and_si128( islead, _mm_add_epi8( rank, leadbase ) ) );
+      key = _mm_add_epi8( key, key );
+      key = _mm_or_si128( _mm_add_epi8( key, key ), _mm_set1_epi8( i ) );
+      best = _mm_max_epu8( best, key );
+      sum = _mm_add_epi8( sum, _mm_shuffle_epi8( values, rank ) );
+    }
+    _mm_storeu_si128( (__m128i*)( winners + b * TRICK_BATCH ), _mm_and_si128( best, three ) );
+    _mm_storeu_si128( (__m128i*)( points + b * TRICK_BATCH ), sum );
+  }
+}
+
+// Two batches at a time, one in each 128 bit lane
+__attribute__(( target( "avx2" ) ))
+static void EvalAvx2( const TrickBatch* batches, int n, cardsuit_t trumph,
+                      unsigned char* winners, unsigned char* points )
+{
+  const __m256i tens = _mm256_setr_epi8( 0, 10, 20, 30, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                         0, 10, 20, 30, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 );
+  const __m256i values = _mm256_setr_epi8( 0, 0, 0, 0, 0, 2, 3, 4, 10, 11, 0, 0, 0, 0, 0, 0,
+                                           0, 0, 0, 0, 0, 2, 3, 4, 10, 11, 0, 0, 0, 0, 0, 0 );
+  const __m256i nine = _mm256_set1_epi8( 9 );
+  const __m256i nineteen = _mm256_set1_epi8( 19 );
+  const __m256i twentynine = _mm256_set1_epi8( 29 );
+  const __m256i trumphs = _mm256_set1_epi8( trumph );
+  const __m256i trumphbase = _mm256_set1_epi8( 2 * N_RANKS + 1 );
+  const __m256i leadbase = _mm256_set1_epi8( N_RANKS + 1 );
+  const __m256i three = _mm256_set1_epi8( 3 );
+  int b = 0;
+  for( ; b + 1 < n; b += 2 ) {
+    __m256i best = _mm256_setzero_si256();
+    __m256i sum = _mm256_setzero_si256();
+    __m256i lead = _mm256_setzero_si256();
+    for( int i = 0; i < N_TRICK_CARDS; i++ ) {
+      __m256i cards = _mm256_inserti128_si256(
+        _mm256_castsi128_si256( _mm_load_si128( (const __m128i*)batches[b].cards[i] ) ),
+        _mm_load_si128( (const __m128i*)batches[b + 1].cards[i] ), 1 );
+      __m256i suit = _mm256_sub_epi8( _mm256_setzero_si256(),
+                                      _mm256_add_epi8( _mm256_add_epi8( _mm256_cmpgt_epi8( cards, nine ),
+                                                                        _mm256_cmpgt_epi8( cards, nineteen ) ),
+                                                       _mm256_cmpgt_epi8( cards, twentynine ) ) );
+      __m256i rank = _mm256_sub_epi8( cards, _mm256_shuffle_epi8( tens, suit ) );
+      if( i == 0 )
+        lead = suit;
+      __m256i istrumph = _mm256_cmpeq_epi8( suit, trumphs );
+      __m256i islead = _mm256_andnot_si256( istrumph, _mm256_cmpeq_epi8( suit, lead ) );
+      __m256i key = _mm256_or_si256( _mm256_and_si256( istrumph, _mm256_add_epi8( rank, trumphbase ) ),
+                                     _mm256_and_si256( islead, _mm256_add_epi8( rank, leadbase ) ) );
+      key = _mm256_add_epi8( key, key );
+      key = _mm256_or_si256( _mm256_add_epi8( key, key ), _mm256_set1_epi8( i ) );
+      best = _mm256_max_epu8( best, key );
+      sum = _mm256_add_epi8( sum, _mm256_shuffle_epi8( values, rank ) );
+    }
+    _mm256_storeu_si256( (__m256i*)( winners + b * TRICK_BATCH ), _mm256_and_si256( best, three ) );
+    _mm256_storeu_si256( (__m256i*)( points + b * TRICK_BATCH ), sum );
+  }
+  if( b < n )
+    EvalSse4( batches + b, 1, trumph, winners + b * TRICK_BATCH, points + b * TRICK_BATCH );
+}
+#endif  // TRICK_BATCH_X86
+
+trickkernel_t BestTrickKernel()
+{
+#ifdef TRICK_BATCH_X86
+  if( __builtin_cpu_supports( "avx2" ) )
+    return TRICK_KERNEL_AVX2;
+  if( __builtin_cpu_supports( "sse4.1" ) )
+    return TRICK_KERNEL_SSE4;
+#endif
+  return TRICK_KERNEL_SCALAR;
+}
+
+void EvalTrickBatches( const TrickBatch* batches, int n, cardsuit_t trumph,
+                       unsigned char* winners, unsigned char* points, trickkernel_t kernel )
+{
+  static const trickkernel_t best = BestTrickKernel();
+  if( kernel == TRICK_KERNEL_BEST || kernel > best )
+    kernel = best;
+  switch( kernel ) {
+#ifdef TRICK_BATCH_X86
+  case TRICK_KERNEL_AVX2:
+    EvalAvx2( batches, n, trumph, winners, points );
+    break;
+  case TRICK_KERNEL_SSE4:
+    EvalSse4( batches, n, trumph, winners, points );
+    break;
+#endif
+  default:
+    EvalScalar( batches, n, trumph, winners, points );
+    break;
+  }
+}
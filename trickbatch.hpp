@@ -0,0 +1,53 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _TRICKBATCH_HPP_
+#define _TRICKBATCH_HPP_ 1
+
+// Forward declarations
+struct TrickBatch;
+
+#include "corecards.hpp"
+
+#define TRICK_BATCH 16  // Worlds per batch
+#define N_TRICK_CARDS 4
+
+// The same trick in TRICK_BATCH worlds, as a structure of arrays: card i
+// of world w is cards[i][w], so each row fills a vector register
+struct TrickBatch
+{
+  alignas( 32 ) cardid_t cards[N_TRICK_CARDS][TRICK_BATCH];
+};
+
+// Kernels the batch evaluation can run on
+enum trickkernel_t { TRICK_KERNEL_SCALAR, TRICK_KERNEL_SSE4, TRICK_KERNEL_AVX2, TRICK_KERNEL_BEST };
+
+// Resolves the complete tricks of n batches: winners gets the position
+// of the winner (0 is the leader) and points the value of the trick, one
+// per world (TRICK_BATCH * n of each). Every kernel gives the same
+// results as TrickWinner() and CardIdValue(); the best one the CPU
+// supports is used unless another is asked for (falling back to scalar
+// if unsupported).
+void EvalTrickBatches( const TrickBatch* batches, int n, cardsuit_t trumph,
+                       unsigned char* winners, unsigned char* points,
+                       trickkernel_t kernel = TRICK_KERNEL_BEST );
+// Best kernel of this CPU
+trickkernel_t BestTrickKernel();
+
+#endif  // _TRICKBATCH_HPP_
@@ -0,0 +1,143 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+// Microbenchmark of the trick winner resolution: the table lookup used by
+// the engine against the list walk the GUI game used to do
+
+#include <cstdio>
+#include <chrono>
+#include "rng.hpp"
+#include "trick.hpp"
+
+#define N_TRICKS 4096
+#define N_PASSES 2000
+
+// Minimal copies of the old card list and player iterator
+struct ListCard
+{
+  cardsuit_t suit;
+  cardtype_t type;
+};
+
+struct ListNode
+{
+  ListCard* data;
+  ListNode* next;
+};
+
+class SeatIterator
+{
+public:
+  SeatIterator(): m_current( 0 ) {}
+  int GetCurrent() const { return m_current; }
+  int GetNext() { return m_current = ( m_current + 1 ) % 4; }
+  void SetCurrent( int seat ) { m_current = seat; }
+private:
+  int m_current;
+};
+
+struct BenchTrick
+{
+  cardid_t cards[4];
+  cardsuit_t trumph;
+  int leader;
+  ListCard list_cards[4];
+  ListNode nodes[4];
+};
+
+static int ListWinner( BenchTrick& trick, SeatIterator& players )
+{
+  ListNode* node = &trick.nodes[0];
+  ListCard* biggest = node->data;
+  int current, winner;
+  current = winner = players.GetCurrent();
+  while( ( node = node->next ) != NULL ) {
+    ListCard* card = node->data;
+    int player = players.GetNext();
+    if( ( card->suit == trick.trumph &&
+          ( biggest->suit != trick.trumph || card->type > biggest->type ) ) ||
+        ( card->suit == biggest->suit && card->type > biggest->type ) ) {
+      biggest = card;
+      winner = player;
+    }
+  }
+  players.SetCurrent( current );
+  return winner;
+}
+
+static int TableWinner( const BenchTrick& trick )
+{
+  int winner = TrickWinner( trick.cards, CardIdSuit( trick.cards[0] ), trick.trumph );
+  return ( trick.leader + winner ) % 4;
+}
+
+int main()
+{
+  static BenchTrick tricks[N_TRICKS];
+  Rng rng( 1 );
+  for( int t = 0; t < N_TRICKS; t++ ) {
+    BenchTrick& trick = tricks[t];
+    trick.trumph = (cardsuit_t)rng.Below( N_SUITS );
+    trick.leader = rng.Below( 4 );
+    for( int i = 0; i < 4; i++ ) {
+      bool repeated;
+      do {
+        trick.cards[i] = (cardid_t)rng.Below( N_CARDS );
+        repeated = false;
+        for( int j = 0; j < i; j++ )
+          repeated |= trick.cards[j] == trick.cards[i];
+      } while( repeated );
+      trick.list_cards[i].suit = CardIdSuit( trick.cards[i] );
+      trick.list_cards[i].type = CardIdType( trick.cards[i] );
+      trick.nodes[i].data = &trick.list_cards[i];
+      trick.nodes[i].next = i < 3 ? &trick.nodes[i + 1] : NULL;
+    }
+  }
+
+  SeatIterator players;
+  for( int t = 0; t < N_TRICKS; t++ ) {
+    players.SetCurrent( tricks[t].leader );
+    if( ListWinner( tricks[t], players ) != TableWinner( tricks[t] ) ) {
+      fprintf( stderr, "Mismatch in trick %d\n", t );
+      return 1;
+    }
+  }
+
+  typedef std::chrono::steady_clock clock_type;
+  unsigned long sum_list = 0, sum_table = 0;
+  clock_type::time_point start = clock_type::now();
+  for( int pass = 0; pass < N_PASSES; pass++ )
+    for( int t = 0; t < N_TRICKS; t++ ) {
+      players.SetCurrent( tricks[t].leader );
+      sum_list += ListWinner( tricks[t], players );
+    }
+  clock_type::time_point middle = clock_type::now();
+  for( int pass = 0; pass < N_PASSES; pass++ )
+    for( int t = 0; t < N_TRICKS; t++ )
+      sum_table += TableWinner( tricks[t] );
+  clock_type::time_point end = clock_type::now();
+
+  double n = (double)N_TRICKS * N_PASSES;
+  double list_ns = std::chrono::duration<double, std::nano>( middle - start ).count() / n;
+  double table_ns = std::chrono::duration<double, std::nano>( end - middle ).count() / n;
+  printf( "List walk:    %6.2f ns/trick (checksum %lu)\n", list_ns, sum_list );
+  printf( "Table lookup: %6.2f ns/trick (checksum %lu)\n", table_ns, sum_table );
+  printf( "Speedup:      %6.2fx\n", list_ns / table_ns );
+  return sum_list == sum_table ? 0 : 1;
+}
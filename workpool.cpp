@@ -0,0 +1,104 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <atomic>
+#include "workpool.hpp"
+
+// Items still to run by a thread, taken from the front by anyone.
+// Each queue gets its own cache line, as all threads hit the counters.
+struct alignas( 64 ) PoolQueue
+{
+  std::atomic<long> next;
+  long end;
+};
+
+static void PoolWorker( PoolJob* job, PoolQueue* queues, int threads, int worker )
+{
+  // Own queue first, then steal from the next ones
+  for( int i = 0; i < threads; i++ ) {
+    PoolQueue& queue = queues[( worker + i ) % threads];
+    long item;
+    while( ( item = queue.next.fetch_add( 1, std::memory_order_relaxed ) ) < queue.end )
+      job->Run( item, worker );
+  }
+}
+
+WorkPool::WorkPool( int threads ):
+  m_job( NULL ), m_round( 0 ), m_busy( 0 ), m_stop( false )
+{
+  if( threads <= 0 )
+    threads = std::thread::hardware_concurrency();
+  m_threads = threads > 0 ? threads : 1;
+  m_queues = new PoolQueue[m_threads];
+  // The calling thread is worker 0
+  for( int i = 1; i < m_threads; i++ )
+    m_workers.push_back( std::thread( &WorkPool::Worker, this, i ) );
+}
+
+WorkPool::~WorkPool()
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_stop = true;
+  }
+  m_start.notify_all();
+  for( size_t i = 0; i < m_workers.size(); i++ )
+    m_workers[i].join();
+  delete[] m_queues;
+}
+
+void WorkPool::Run( PoolJob& job, long items )
+{
+  for( int i = 0; i < m_threads; i++ ) {
+    m_queues[i].next = items * i / m_threads;
+    m_queues[i].end = items * ( i + 1 ) / m_threads;
+  }
+  if( !m_workers.empty() ) {
+    {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      m_job = &job;
+      m_busy = m_workers.size();
+      m_round++;
+    }
+    m_start.notify_all();
+  }
+  PoolWorker( &job, m_queues, m_threads, 0 );
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while( m_busy )
+    m_done.wait( lock );
+}
+
+void WorkPool::Worker( int worker )
+{
+  unsigned long round = 0;
+  std::unique_lock<std::mutex> lock( m_mutex );
+  for( ;; ) {
+    while( m_round == round && !m_stop )
+      m_start.wait( lock );
+    if( m_stop )
+      return;
+    round = m_round;
+    PoolJob* job = m_job;
+    lock.unlock();
+    PoolWorker( job, m_queues, m_threads, worker );
+    lock.lock();
+    if( !--m_busy )
+      m_done.notify_one();
+  }
+}
@@ -0,0 +1,70 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _WORKPOOL_HPP_
+#define _WORKPOOL_HPP_ 1
+
+// Forward declarations
+class PoolJob;
+class WorkPool;
+struct PoolQueue;
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work split into numbered items, run by a WorkPool
+class PoolJob
+{
+public:
+  virtual ~PoolJob() {}
+  // Called once for every item, worker is the number of the thread
+  // running it (0 to GetThreads() - 1), e.g. to index per thread data
+  virtual void Run( long item, int worker ) = 0;
+};
+
+// Runs the items of a job on several threads. Each thread starts with
+// an equal share of the items and steals from the others when done.
+// The calling thread is one of them, the others live as long as the pool
+// and wait between jobs.
+class WorkPool
+{
+public:
+  // 0 threads means one per hardware thread
+  WorkPool( int threads = 0 );
+  ~WorkPool();
+  int GetThreads() const { return m_threads; }
+  // Returns when all the items have been run. One job at a time.
+  void Run( PoolJob& job, long items );
+private:
+  void Worker( int worker );
+  int m_threads;
+  PoolQueue* m_queues;  // One per thread
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_start;
+  std::condition_variable m_done;
+  PoolJob* m_job;
+  unsigned long m_round;  // Jobs started
+  int m_busy;  // Workers still on the job
+  bool m_stop;
+};
+
+#endif  // _WORKPOOL_HPP_
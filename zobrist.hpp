@@ -0,0 +1,68 @@
+/*
+sueca - An implementation of the Portuguese game "Sueca" in C++ and wxWidgets
+Copyright (C) 2003-2024 Rodrigo Araujo
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef _ZOBRIST_HPP_
+#define _ZOBRIST_HPP_ 1
+
+// Forward declarations
+struct ZobristKeys;
+
+#include <stdint.h>
+#include "engine.hpp"
+
+// Random keys for Zobrist hashing of positions: the hash of a position
+// is the xor of the keys of its parts
+struct ZobristKeys
+{
+  uint64_t turn[N_SEATS];  // Seat to move
+  uint64_t trumph[N_SUITS];
+  constexpr ZobristKeys(): turn(), trumph()
+  {
+    // splitmix64 with a fixed seed, so hashes are the same on every run
+    uint64_t x = 0x5eca5eca5eca5ecaULL;
+    // Skip the keys once drawn for the cards in hand and in the trick,
+    // so these keep their values and stored tables stay valid
+    for( int i = 0; i < 2 * N_SEATS * N_CARDS; i++ )
+      Next( x );
+    for( int i = 0; i < N_SEATS; i++ )
+      turn[i] = Next( x );
+    for( int i = 0; i < N_SUITS; i++ )
+      trumph[i] = Next( x );
+  }
+  static constexpr uint64_t Next( uint64_t& x )
+  {
+    uint64_t z = ( x += 0x9e3779b97f4a7c15ULL );
+    z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+    z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebULL;
+    return z ^ ( z >> 31 );
+  }
+};
+
+extern const ZobristKeys zobrist_keys;
+
+// Spreads the bits of a value over the whole hash (splitmix64 mixing),
+// for hashing things other than a card layout
+inline uint64_t MixBits( uint64_t z )
+{
+  z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+  z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebULL;
+  return z ^ ( z >> 31 );
+}
+
+#endif  // _ZOBRIST_HPP_